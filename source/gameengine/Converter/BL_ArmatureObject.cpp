@@ -45,7 +45,9 @@
 
 #include "BL_Action.h"
 #include "BL_BlenderSceneConverter.h"
+#include "BL_PoseCache.h"
 #include "KX_Globals.h"
+#include "KX_Scene.h"
 
 /**
  * Move here pose function for game engine so that we can mix with GE objects
@@ -432,10 +434,8 @@ void BL_ArmatureObject::ApplyPose()
 
 void BL_ArmatureObject::SetPoseByAction(bAction *action, AnimationEvalContext *evalCtx)
 {
-  PointerRNA ptrrna;
-  RNA_id_pointer_create(&m_objArma->id, &ptrrna);
-
-  animsys_evaluate_action(&ptrrna, action, evalCtx, false);
+  // Armatures playing the same action at the same frame share the evaluated pose.
+  GetScene()->GetPoseCache()->EvaluateAction(m_objArma, action, evalCtx);
 }
 
 void BL_ArmatureObject::BlendInPose(bPose *blend_pose, float weight, short mode)
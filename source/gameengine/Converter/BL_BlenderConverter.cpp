@@ -56,12 +56,15 @@
 #include "BL_ActionActuator.h"
 #include "BL_BlenderDataConversion.h"
 #include "BL_BlenderSceneConverter.h"
+#include "BL_PoseCache.h"
 #include "DummyPhysicsEnvironment.h"
 #include "EXP_StringValue.h"
 #include "KX_GameObject.h"
 #include "KX_LibLoadStatus.h"
 #include "KX_PythonInit.h"  // So we can handle adding new text datablocks for Python to import
+#include "KX_Scene.h"
 #include "LA_SystemCommandLine.h"
+#include "PIL_time.h"
 #include "RAS_BucketManager.h"
 
 #ifdef WITH_BULLET
@@ -106,7 +109,11 @@ void BL_BlenderConverter::SceneSlot::Merge(const BL_BlenderSceneConverter *conve
 }
 
 BL_BlenderConverter::BL_BlenderConverter(Main *maggie, KX_KetsjiEngine *engine)
-    : m_maggie(maggie), m_ketsjiEngine(engine), m_alwaysUseExpandFraming(false)
+    : m_mergeBudget(0.0),
+      m_mergeState(nullptr),
+      m_maggie(maggie),
+      m_ketsjiEngine(engine),
+      m_alwaysUseExpandFraming(false)
 {
   BKE_main_id_tag_all(maggie, LIB_TAG_DOIT, false);  // avoid re-tagging later on
   m_threadinfo.m_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_LOW);
@@ -121,6 +128,10 @@ BL_BlenderConverter::~BL_BlenderConverter()
 
   m_DynamicMaggie.clear();
 
+  if (m_mergeState) {
+    delete m_mergeState;
+  }
+
   /* Thread infos like mutex must be freed after FreeBlendFile function.
      Because it needs to lock the mutex, even if there's no active task when it's
      in the scene converter destructor. */
@@ -296,31 +307,77 @@ Main *BL_BlenderConverter::GetMainDynamicPath(const std::string &path) const
   return nullptr;
 }
 
+static bool libload_priority_greater(KX_LibLoadStatus *status1, KX_LibLoadStatus *status2)
+{
+  return status1->GetPriority() > status2->GetPriority();
+}
+
 void BL_BlenderConverter::MergeAsyncLoads()
 {
-  std::vector<KX_Scene *> *merge_scenes;
+  MergeAsyncLoads(m_mergeBudget);
+}
 
-  std::vector<KX_LibLoadStatus *>::iterator mit;
-  std::vector<KX_Scene *>::iterator sit;
+void BL_BlenderConverter::MergeAsyncLoads(double budget)
+{
+  const double starttime = PIL_check_seconds_timer();
+  const double deadline = (budget > 0.0) ? starttime + budget : 0.0;
+  unsigned int merged = 0;
 
   m_threadinfo.m_mutex.Lock();
 
-  for (mit = m_mergequeue.begin(); mit != m_mergequeue.end(); ++mit) {
-    merge_scenes = (std::vector<KX_Scene *> *)(*mit)->GetData();
+  // A partially merged scene keeps its libload first until the scene is complete.
+  if (!m_mergeState) {
+    std::stable_sort(m_mergequeue.begin(), m_mergequeue.end(), libload_priority_greater);
+  }
+
+  while (!m_mergequeue.empty()) {
+    KX_LibLoadStatus *status = m_mergequeue.front();
+    std::vector<KX_Scene *> *merge_scenes = (std::vector<KX_Scene *> *)status->GetData();
+    // The scenes of a cancelled libload are only freed, with their converter slot.
+    const bool cancelled = status->IsCancelled();
+
+    status->SetPhase(KX_LibLoadStatus::PHASE_MERGE);
+
+    while (!merge_scenes->empty()) {
+      KX_Scene *scene = merge_scenes->front();
+      const bool started = (m_mergeState && m_mergeState->m_other == scene);
 
-    for (sit = merge_scenes->begin(); sit != merge_scenes->end(); ++sit) {
-      (*mit)->GetMergeScene()->MergeScene(*sit);
-      delete (*sit);
+      // Always merge something to ensure progress, then continue at the next frame.
+      if (!started && deadline > 0.0 && merged > 0 && PIL_check_seconds_timer() > deadline) {
+        m_threadinfo.m_mutex.Unlock();
+        return;
+      }
+
+      // The objects of a partially merged scene already moved, the merge must be completed.
+      if (!cancelled || started) {
+        if (!started) {
+          m_mergeState = new KX_SceneMergeState(scene);
+        }
+        ++merged;
+        if (!status->GetMergeScene()->MergeSceneStep(*m_mergeState, deadline)) {
+          m_threadinfo.m_mutex.Unlock();
+          return;
+        }
+        delete m_mergeState;
+        m_mergeState = nullptr;
+        status->AddProgress(0.1f / status->GetSceneCount());
+        // The converter slot of the scene was moved to the merge scene.
+        delete scene;
+      }
+      else {
+        RemoveScene(scene);
+      }
+
+      merge_scenes->erase(merge_scenes->begin());
     }
 
     delete merge_scenes;
-    (*mit)->SetData(nullptr);
+    status->SetData(nullptr);
 
-    (*mit)->Finish();
+    m_mergequeue.erase(m_mergequeue.begin());
+    status->Finish();
   }
 
-  m_mergequeue.clear();
-
   m_threadinfo.m_mutex.Unlock();
 }
 
@@ -329,7 +386,7 @@ void BL_BlenderConverter::FinalizeAsyncLoads()
   // Finish all loading libraries.
   BLI_task_pool_work_and_wait(m_threadinfo.m_pool);
   // Merge all libraries data in the current scene, to avoid memory leak of unmerged scenes.
-  MergeAsyncLoads();
+  MergeAsyncLoads(0.0);
 }
 
 void BL_BlenderConverter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
@@ -339,29 +396,80 @@ void BL_BlenderConverter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
   m_threadinfo.m_mutex.Unlock();
 }
 
+KX_LibLoadStatus *BL_BlenderConverter::PopConvertQueue()
+{
+  m_threadinfo.m_mutex.Lock();
+
+  // First of the libloads of highest priority.
+  std::vector<KX_LibLoadStatus *>::iterator it = std::min_element(
+      m_convertqueue.begin(), m_convertqueue.end(), libload_priority_greater);
+  KX_LibLoadStatus *status = *it;
+  m_convertqueue.erase(it);
+
+  m_threadinfo.m_mutex.Unlock();
+
+  return status;
+}
+
+void BL_BlenderConverter::CancelAsyncLoad(KX_LibLoadStatus *status)
+{
+  m_threadinfo.m_mutex.Lock();
+  if (!status->IsFinished()) {
+    status->SetCancelled();
+  }
+  m_threadinfo.m_mutex.Unlock();
+}
+
+bool BL_BlenderConverter::IsAsyncLoadCancelled(KX_LibLoadStatus *status)
+{
+  m_threadinfo.m_mutex.Lock();
+  const bool cancelled = status->IsCancelled();
+  m_threadinfo.m_mutex.Unlock();
+
+  return cancelled;
+}
+
+double BL_BlenderConverter::GetMergeBudget() const
+{
+  return m_mergeBudget;
+}
+
+void BL_BlenderConverter::SetMergeBudget(double budget)
+{
+  m_mergeBudget = budget;
+}
+
 static void async_convert(TaskPool *pool, void *ptr, int UNUSED(threadid))
 {
-  KX_Scene *new_scene = nullptr;
-  KX_LibLoadStatus *status = (KX_LibLoadStatus *)ptr;
+  BL_BlenderConverter *converter = (BL_BlenderConverter *)ptr;
+  /* Each task converts the pending libload of highest priority
+   * which is not necessarily the one pushed with this task. */
+  KX_LibLoadStatus *status = converter->PopConvertQueue();
   std::vector<Scene *> *scenes = (std::vector<Scene *> *)status->GetData();
   std::vector<KX_Scene *> *merge_scenes =
       new std::vector<KX_Scene *>();  // Deleted in MergeAsyncLoads
 
-  for (unsigned int i = 0; i < scenes->size(); ++i) {
-    new_scene = status->GetEngine()->CreateScene((*scenes)[i], true);
+  status->SetPhase(KX_LibLoadStatus::PHASE_CONVERT);
+
+  for (Scene *scene : *scenes) {
+    if (converter->IsAsyncLoadCancelled(status)) {
+      break;
+    }
+
+    KX_Scene *new_scene = status->GetEngine()->CreateScene(scene, true);
 
     if (new_scene) {
       merge_scenes->push_back(new_scene);
     }
 
-    status->AddProgress((1.0f / scenes->size()) *
-                        0.9f);  // We'll call conversion 90% and merging 10% for now
+    // We'll call conversion 90% and merging 10% for now.
+    status->AddProgress(0.9f / scenes->size());
   }
 
   delete scenes;
   status->SetData(merge_scenes);
 
-  status->GetConverter()->AddScenesToMergeQueue(status);
+  converter->AddScenesToMergeQueue(status);
 }
 
 KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFileMemory(void *data,
@@ -370,21 +478,26 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFileMemory(void *data,
                                                            char *group,
                                                            KX_Scene *scene_merge,
                                                            char **err_str,
-                                                           short options)
+                                                           short options,
+                                                           int priority)
 {
   BlendHandle *bpy_openlib = BLO_blendhandle_from_memory(data, length);
 
   // Error checking is done in LinkBlendFile
-  return LinkBlendFile(bpy_openlib, path, group, scene_merge, err_str, options);
+  return LinkBlendFile(bpy_openlib, path, group, scene_merge, err_str, options, priority);
 }
 
-KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFilePath(
-    const char *filepath, char *group, KX_Scene *scene_merge, char **err_str, short options)
+KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFilePath(const char *filepath,
+                                                         char *group,
+                                                         KX_Scene *scene_merge,
+                                                         char **err_str,
+                                                         short options,
+                                                         int priority)
 {
   BlendHandle *bpy_openlib = BLO_blendhandle_from_file(filepath, nullptr);
 
   // Error checking is done in LinkBlendFile
-  return LinkBlendFile(bpy_openlib, filepath, group, scene_merge, err_str, options);
+  return LinkBlendFile(bpy_openlib, filepath, group, scene_merge, err_str, options, priority);
 }
 
 static void load_datablocks(Main *main_tmp, BlendHandle *bpy_openlib, const char *path, int idcode)
@@ -410,7 +523,8 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
                                                      char *group,
                                                      KX_Scene *scene_merge,
                                                      char **err_str,
-                                                     short options)
+                                                     short options,
+                                                     int priority)
 {
   Main *main_newlib;  // stored as a dynamic 'main' until we free it
   const int idcode = BKE_idtype_idcode_from_name(group);
@@ -471,6 +585,7 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
   BLI_strncpy(main_newlib->name, path, sizeof(main_newlib->name));
 
   status = new KX_LibLoadStatus(this, m_ketsjiEngine, scene_merge, path);
+  status->SetPriority(priority);
 
   if (idcode == ID_ME) {
     // Convert all new meshes into BGE meshes
@@ -534,8 +649,14 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
 
     if (options & LIB_LOAD_ASYNC) {
       status->SetData(scenes);
+      status->SetSceneCount(scenes->size());
+
+      m_threadinfo.m_mutex.Lock();
+      m_convertqueue.push_back(status);
+      m_threadinfo.m_mutex.Unlock();
+
       BLI_task_pool_push(
-          m_threadinfo.m_pool, (TaskRunFunction)async_convert, (void *)status, false, NULL);
+          m_threadinfo.m_pool, (TaskRunFunction)async_convert, (void *)this, false, NULL);
     }
 
 #ifdef WITH_PYTHON
@@ -641,6 +762,8 @@ bool BL_BlenderConverter::FreeBlendFile(Main *maggie)
           ++it;
         }
       }
+      // The channels of the freed actions are cached by their address.
+      scene->GetPoseCache()->ClearActions();
 
       // removed tagged objects and meshes
       CListValue<KX_GameObject> *obj_lists[] = {
@@ -45,6 +45,7 @@ class CStringValue;
 class BL_BlenderSceneConverter;
 class KX_KetsjiEngine;
 class KX_LibLoadStatus;
+class KX_Scene;
 class KX_BlenderMaterial;
 class BL_InterpolatorList;
 class SCA_IActuator;
@@ -61,6 +62,7 @@ struct bActuator;
 struct bController;
 struct TaskPool;
 struct Depsgraph;
+struct KX_SceneMergeState;
 
 template<class Value> using UniquePtrList = std::vector<std::unique_ptr<Value>>;
 
@@ -91,7 +93,13 @@ class BL_BlenderConverter {
 
   // Saved KX_LibLoadStatus objects
   std::map<std::string, KX_LibLoadStatus *> m_status_map;
+  /// Asynchronous libloads waiting for their conversion task.
+  std::vector<KX_LibLoadStatus *> m_convertqueue;
   std::vector<KX_LibLoadStatus *> m_mergequeue;
+  /// Maximum time in seconds spent merging asynchronous libloads per logic frame, 0 for no limit.
+  double m_mergeBudget;
+  /// Progress of the scene being merged, nullptr when no scene is partially merged.
+  KX_SceneMergeState *m_mergeState;
 
   Main *m_maggie;
   std::vector<Main *> m_DynamicMaggie;
@@ -99,6 +107,8 @@ class BL_BlenderConverter {
   KX_KetsjiEngine *m_ketsjiEngine;
   bool m_alwaysUseExpandFraming;
 
+  void MergeAsyncLoads(double budget);
+
  public:
   BL_BlenderConverter(Main *maggie, KX_KetsjiEngine *engine);
   virtual ~BL_BlenderConverter();
@@ -134,15 +144,21 @@ class BL_BlenderConverter {
                                         char *group,
                                         KX_Scene *scene_merge,
                                         char **err_str,
-                                        short options);
-  KX_LibLoadStatus *LinkBlendFilePath(
-      const char *path, char *group, KX_Scene *scene_merge, char **err_str, short options);
+                                        short options,
+                                        int priority);
+  KX_LibLoadStatus *LinkBlendFilePath(const char *path,
+                                      char *group,
+                                      KX_Scene *scene_merge,
+                                      char **err_str,
+                                      short options,
+                                      int priority);
   KX_LibLoadStatus *LinkBlendFile(BlendHandle *bpy_openlib,
                                   const char *path,
                                   char *group,
                                   KX_Scene *scene_merge,
                                   char **err_str,
-                                  short options);
+                                  short options,
+                                  int priority);
 
   bool FreeBlendFile(Main *maggie);
   bool FreeBlendFile(const std::string &path);
@@ -151,9 +167,22 @@ class BL_BlenderConverter {
 
   void MergeScene(KX_Scene *to, KX_Scene *from);
 
+  /** Merge the converted scenes of asynchronous libloads, highest priority first.
+   * The scenes are merged object by object until the merge budget is exceeded, the merge
+   * then continues at the next call. The objects of a scene are activated once the whole
+   * scene is merged.
+   */
   void MergeAsyncLoads();
   void FinalizeAsyncLoads();
   void AddScenesToMergeQueue(KX_LibLoadStatus *status);
+  /// Remove and return the pending asynchronous libload of highest priority.
+  KX_LibLoadStatus *PopConvertQueue();
+
+  void CancelAsyncLoad(KX_LibLoadStatus *status);
+  bool IsAsyncLoadCancelled(KX_LibLoadStatus *status);
+
+  double GetMergeBudget() const;
+  void SetMergeBudget(double budget);
 
   void PrintStats();
 
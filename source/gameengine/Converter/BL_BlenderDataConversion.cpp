@@ -67,6 +67,7 @@
 #include "BKE_material.h" /* give_current_material */
 #include "BKE_object.h"
 #include "BKE_scene.h"
+#include "BLI_task.h"
 #include "DEG_depsgraph_query.h"
 #include "DNA_camera_types.h"
 #include "DNA_material_types.h"
@@ -330,104 +331,104 @@ static RAS_MaterialBucket *BL_material_from_mesh(Material *ma,
   return bucket;
 }
 
-/* blenderobj can be nullptr, make sure its checked for */
-RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
-                               Object *blenderobj,
-                               KX_Scene *scene,
-                               RAS_Rasterizer *rasty,
-                               BL_BlenderSceneConverter *converter,
-                               bool libloading,
-                               bool converting_during_runtime)
-{
-  RAS_MeshObject *meshobj;
-  int lightlayer = blenderobj ? blenderobj->lay : (1 << 20) - 1;  // all layers if no object.
+/** Intermediate state of a mesh conversion, the conversion is split in stages so that
+ * the stages not touching shared scene data can be run in parallel over several meshes.
+ */
+struct BL_MeshConversion {
+  struct ConvertedMaterial {
+    Material *ma;
+    RAS_MeshMaterial *meshmat;
+    bool visible;
+    bool twoside;
+    bool collider;
+    bool wire;
+  };
 
-  // Without checking names, we get some reuse we don't want that can cause
-  // problems with material LoDs.
-  if (blenderobj && ((meshobj = converter->FindGameMesh(mesh /*, ob->lay*/)) != nullptr)) {
-    const std::string bge_name = meshobj->GetName();
-    const std::string blender_name = ((ID *)blenderobj->data)->name + 2;
-    if (bge_name == blender_name) {
-      return meshobj;
-    }
-  }
+  Mesh *mesh;
+  /// Can be nullptr, make sure its checked for.
+  Object *blenderobj;
+  Mesh *final_me;
+  DerivedMesh *dm;
 
-  // Get DerivedMesh data
-  bContext *C = KX_GetActiveEngine()->GetContext();
-  Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
-  Object *ob_eval = DEG_get_evaluated_object(depsgraph, blenderobj);
-  Mesh *final_me = (Mesh *)ob_eval->data;
-  DerivedMesh *dm = CDDM_from_mesh(final_me);
-  DM_ensure_tessface(dm);
+  const float (*normals)[3];
+  float (*tangent)[4];
+  unsigned short uvLayers;
+  unsigned short colorLayers;
+  RAS_MeshObject::LayersInfo layersInfo;
 
-  const MVert *mverts = dm->getVertArray(dm);
-  const int totverts = dm->getNumVerts(dm);
+  RAS_MeshObject *meshobj;
+  std::vector<ConvertedMaterial> convertedMats;
+};
 
-  const MFace *mfaces = dm->getTessFaceArray(dm);
-  const MPoly *mpolys = (MPoly *)dm->getPolyArray(dm);
-  const MLoop *mloops = (MLoop *)dm->getLoopArray(dm);
-  const MEdge *medges = (MEdge *)dm->getEdgeArray(dm);
-  const unsigned int numpolys = dm->getNumPolys(dm);
-  const int totfaces = dm->getNumTessFaces(dm);
-  const int *mfaceToMpoly = (int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
+/// Extract the derived mesh data, doesn't touch any game engine data.
+static void bl_mesh_conversion_extract(BL_MeshConversion &conv, Depsgraph *depsgraph)
+{
+  Object *ob_eval = DEG_get_evaluated_object(depsgraph, conv.blenderobj);
+  conv.final_me = (Mesh *)ob_eval->data;
+  DerivedMesh *dm = conv.dm = CDDM_from_mesh(conv.final_me);
+  DM_ensure_tessface(dm);
 
   if (CustomData_get_layer_index(&dm->loopData, CD_NORMAL) == -1) {
-    dm->calcLoopNormals(dm, (final_me->flag & ME_AUTOSMOOTH), final_me->smoothresh);
+    dm->calcLoopNormals(dm, (conv.final_me->flag & ME_AUTOSMOOTH), conv.final_me->smoothresh);
   }
-  const float(*normals)[3] = (float(*)[3])dm->getLoopDataArray(dm, CD_NORMAL);
+  conv.normals = (float(*)[3])dm->getLoopDataArray(dm, CD_NORMAL);
 
   /* Extract available layers.
    * Get the active color and uv layer. */
   const short activeUv = CustomData_get_active_layer(&dm->loopData, CD_MLOOPUV);
   const short activeColor = CustomData_get_active_layer(&dm->loopData, CD_MLOOPCOL);
 
-  RAS_MeshObject::LayersInfo layersInfo;
+  RAS_MeshObject::LayersInfo &layersInfo = conv.layersInfo;
   layersInfo.activeUv = (activeUv == -1) ? 0 : activeUv;
   layersInfo.activeColor = (activeColor == -1) ? 0 : activeColor;
 
-  const unsigned short uvLayers = CustomData_number_of_layers(&dm->loopData, CD_MLOOPUV);
-  const unsigned short colorLayers = CustomData_number_of_layers(&dm->loopData, CD_MLOOPCOL);
+  conv.uvLayers = CustomData_number_of_layers(&dm->loopData, CD_MLOOPUV);
+  conv.colorLayers = CustomData_number_of_layers(&dm->loopData, CD_MLOOPCOL);
 
   // Extract UV loops.
-  for (unsigned short i = 0; i < uvLayers; ++i) {
+  for (unsigned short i = 0; i < conv.uvLayers; ++i) {
     const std::string name = CustomData_get_layer_name(&dm->loopData, CD_MLOOPUV, i);
     MLoopUV *uv = (MLoopUV *)CustomData_get_layer_n(&dm->loopData, CD_MLOOPUV, i);
     layersInfo.layers.push_back({uv, nullptr, i, name});
   }
   // Extract color loops.
-  for (unsigned short i = 0; i < colorLayers; ++i) {
+  for (unsigned short i = 0; i < conv.colorLayers; ++i) {
     const std::string name = CustomData_get_layer_name(&dm->loopData, CD_MLOOPCOL, i);
     MLoopCol *col = (MLoopCol *)CustomData_get_layer_n(&dm->loopData, CD_MLOOPCOL, i);
     layersInfo.layers.push_back({nullptr, col, i, name});
   }
 
-  float(*tangent)[4] = nullptr;
-  if (uvLayers > 0) {
+  conv.tangent = nullptr;
+  if (conv.uvLayers > 0) {
     if (CustomData_get_layer_index(&dm->loopData, CD_TANGENT) == -1) {
       DM_calc_loop_tangents(dm, true, nullptr, 0);
     }
-    tangent = (float(*)[4])dm->getLoopDataArray(dm, CD_TANGENT);
+    conv.tangent = (float(*)[4])dm->getLoopDataArray(dm, CD_TANGENT);
   }
+}
+
+/// Create the mesh object and its materials, materials and buckets are shared by the scene.
+static void bl_mesh_conversion_materials(BL_MeshConversion &conv,
+                                         KX_Scene *scene,
+                                         RAS_Rasterizer *rasty,
+                                         BL_BlenderSceneConverter *converter,
+                                         bool converting_during_runtime)
+{
+  Object *blenderobj = conv.blenderobj;
+  Mesh *final_me = conv.final_me;
+  const int lightlayer = blenderobj ? blenderobj->lay : (1 << 20) - 1;  // all layers if no object.
 
-  meshobj = new RAS_MeshObject(mesh, final_me->totvert, blenderobj, layersInfo);
-  meshobj->m_sharedvertex_map.resize(totverts);
+  RAS_MeshObject *meshobj = conv.meshobj = new RAS_MeshObject(
+      conv.mesh, final_me->totvert, blenderobj, conv.layersInfo);
+  meshobj->m_sharedvertex_map.resize(conv.dm->getNumVerts(conv.dm));
 
   // Initialize vertex format with used uv and color layers.
   RAS_VertexFormat vertformat;
-  vertformat.uvSize = max_ii(1, uvLayers);
-  vertformat.colorSize = max_ii(1, colorLayers);
-
-  struct ConvertedMaterial {
-    Material *ma;
-    RAS_MeshMaterial *meshmat;
-    bool visible;
-    bool twoside;
-    bool collider;
-    bool wire;
-  };
+  vertformat.uvSize = max_ii(1, conv.uvLayers);
+  vertformat.colorSize = max_ii(1, conv.colorLayers);
 
   const unsigned short totmat = max_ii(final_me->totcol, 1);
-  std::vector<ConvertedMaterial> convertedMats(totmat);
+  conv.convertedMats.resize(totmat);
 
   // Convert all the materials contained in the mesh.
   for (unsigned short i = 0; i < totmat; ++i) {
@@ -446,13 +447,34 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
     RAS_MaterialBucket *bucket = BL_material_from_mesh(ma, lightlayer, scene, rasty, converter, converting_during_runtime);
     RAS_MeshMaterial *meshmat = meshobj->AddMaterial(bucket, i, vertformat);
 
-    convertedMats[i] = {ma,
-                        meshmat,
-                        ((ma->game.flag & GEMAT_INVISIBLE) == 0),
-                        ((ma->game.flag & GEMAT_BACKCULL) == 0),
-                        ((ma->game.flag & GEMAT_NOPHYSICS) == 0),
-                        bucket->IsWire()};
+    conv.convertedMats[i] = {ma,
+                             meshmat,
+                             ((ma->game.flag & GEMAT_INVISIBLE) == 0),
+                             ((ma->game.flag & GEMAT_BACKCULL) == 0),
+                             ((ma->game.flag & GEMAT_NOPHYSICS) == 0),
+                             bucket->IsWire()};
   }
+}
+
+/// Fill vertices and polygons, only touches data owned by the mesh object.
+static void bl_mesh_conversion_geometry(BL_MeshConversion &conv)
+{
+  DerivedMesh *dm = conv.dm;
+  RAS_MeshObject *meshobj = conv.meshobj;
+
+  const MVert *mverts = dm->getVertArray(dm);
+  const int totverts = dm->getNumVerts(dm);
+
+  const MFace *mfaces = dm->getTessFaceArray(dm);
+  const MPoly *mpolys = (MPoly *)dm->getPolyArray(dm);
+  const MLoop *mloops = (MLoop *)dm->getLoopArray(dm);
+  const MEdge *medges = (MEdge *)dm->getEdgeArray(dm);
+  const unsigned int numpolys = dm->getNumPolys(dm);
+  const int totfaces = dm->getNumTessFaces(dm);
+  const int *mfaceToMpoly = (int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
+
+  const float(*normals)[3] = conv.normals;
+  const float(*tangent)[4] = conv.tangent;
 
   std::vector<std::vector<unsigned int>> mpolyToMface(numpolys);
   // Generate a list of all mfaces wrapped by a mpoly.
@@ -466,7 +488,7 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
   for (unsigned int i = 0; i < numpolys; ++i) {
     const MPoly &mpoly = mpolys[i];
 
-    const ConvertedMaterial &mat = convertedMats[mpoly.mat_nr];
+    const BL_MeshConversion::ConvertedMaterial &mat = conv.convertedMats[mpoly.mat_nr];
     RAS_MeshMaterial *meshmat = mat.meshmat;
 
     // Mark face as flat, so vertices are split.
@@ -485,7 +507,7 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
       MT_Vector2 uvs[RAS_Texture::MaxUnits];
       unsigned int rgba[RAS_Texture::MaxUnits];
 
-      BL_GetUvRgba(layersInfo.layers, j, uvs, rgba, uvLayers, colorLayers);
+      BL_GetUvRgba(conv.layersInfo.layers, j, uvs, rgba, conv.uvLayers, conv.colorLayers);
 
       // Add tracked vertices by the mpoly.
       vertices[vertid] = meshobj->AddVertex(meshmat, pt, uvs, tan, rgba, no, flat, vertid);
@@ -515,6 +537,14 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
       meshobj->AddPolygon(meshmat, nverts, indices, mat.visible, mat.collider, mat.twoside);
     }
   }
+}
+
+/// Finalize the mesh object and register it in the converter.
+static RAS_MeshObject *bl_mesh_conversion_end(BL_MeshConversion &conv,
+                                              BL_BlenderSceneConverter *converter,
+                                              bool libloading)
+{
+  RAS_MeshObject *meshobj = conv.meshobj;
 
   // keep meshobj->m_sharedvertex_map for reinstance phys mesh.
   // 2.49a and before it did: meshobj->m_sharedvertex_map.clear();
@@ -531,12 +561,138 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
     }
   }
 
-  dm->release(dm);
+  conv.dm->release(conv.dm);
+  conv.dm = nullptr;
 
-  converter->RegisterGameMesh(meshobj, mesh);
+  converter->RegisterGameMesh(meshobj, conv.mesh);
   return meshobj;
 }
 
+static RAS_MeshObject *bl_find_converted_mesh(Mesh *mesh,
+                                              Object *blenderobj,
+                                              BL_BlenderSceneConverter *converter)
+{
+  // Without checking names, we get some reuse we don't want that can cause
+  // problems with material LoDs.
+  RAS_MeshObject *meshobj;
+  if (blenderobj && ((meshobj = converter->FindGameMesh(mesh /*, ob->lay*/)) != nullptr)) {
+    const std::string bge_name = meshobj->GetName();
+    const std::string blender_name = ((ID *)blenderobj->data)->name + 2;
+    if (bge_name == blender_name) {
+      return meshobj;
+    }
+  }
+
+  return nullptr;
+}
+
+/* blenderobj can be nullptr, make sure its checked for */
+RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
+                               Object *blenderobj,
+                               KX_Scene *scene,
+                               RAS_Rasterizer *rasty,
+                               BL_BlenderSceneConverter *converter,
+                               bool libloading,
+                               bool converting_during_runtime)
+{
+  RAS_MeshObject *meshobj = bl_find_converted_mesh(mesh, blenderobj, converter);
+  if (meshobj) {
+    return meshobj;
+  }
+
+  // Get DerivedMesh data
+  bContext *C = KX_GetActiveEngine()->GetContext();
+  Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
+
+  BL_MeshConversion conv;
+  conv.mesh = mesh;
+  conv.blenderobj = blenderobj;
+
+  bl_mesh_conversion_extract(conv, depsgraph);
+  bl_mesh_conversion_materials(conv, scene, rasty, converter, converting_during_runtime);
+  bl_mesh_conversion_geometry(conv);
+
+  return bl_mesh_conversion_end(conv, converter, libloading);
+}
+
+struct BL_MeshConversionTaskData {
+  std::vector<BL_MeshConversion> *conversions;
+  Depsgraph *depsgraph;
+};
+
+static void bl_mesh_conversion_extract_task(void *__restrict userdata,
+                                            const int iter,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BL_MeshConversionTaskData *data = (BL_MeshConversionTaskData *)userdata;
+  bl_mesh_conversion_extract((*data->conversions)[iter], data->depsgraph);
+}
+
+static void bl_mesh_conversion_geometry_task(void *__restrict userdata,
+                                             const int iter,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BL_MeshConversionTaskData *data = (BL_MeshConversionTaskData *)userdata;
+  bl_mesh_conversion_geometry((*data->conversions)[iter]);
+}
+
+/** Convert all the meshes used by a list of objects ahead of the objects conversion.
+ * Derived mesh extraction and geometry filling are run in parallel per mesh, materials
+ * creation and mesh registration stay on the calling thread as they touch the scene buckets
+ * and the converter maps. The objects conversion then reuses the registered meshes.
+ */
+static void bl_ConvertMeshes(const std::vector<Object *> &objects,
+                             KX_Scene *scene,
+                             RAS_Rasterizer *rasty,
+                             BL_BlenderSceneConverter *converter,
+                             bool libloading,
+                             bool converting_during_runtime)
+{
+  std::vector<BL_MeshConversion> conversions;
+  std::set<Mesh *> meshes;
+
+  for (Object *ob : objects) {
+    if (ob->type != OB_MESH) {
+      continue;
+    }
+
+    Mesh *mesh = static_cast<Mesh *>(ob->data);
+    // The first object using a mesh gives its materials, as with a serial conversion.
+    if (!meshes.insert(mesh).second || bl_find_converted_mesh(mesh, ob, converter)) {
+      continue;
+    }
+
+    BL_MeshConversion conv;
+    conv.mesh = mesh;
+    conv.blenderobj = ob;
+    conversions.push_back(conv);
+  }
+
+  if (conversions.empty()) {
+    return;
+  }
+
+  bContext *C = KX_GetActiveEngine()->GetContext();
+  BL_MeshConversionTaskData data = {&conversions, CTX_data_depsgraph_on_load(C)};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (conversions.size() > 1);
+  settings.min_iter_per_thread = 1;
+
+  BLI_task_parallel_range(0, conversions.size(), &data, bl_mesh_conversion_extract_task, &settings);
+
+  for (BL_MeshConversion &conv : conversions) {
+    bl_mesh_conversion_materials(conv, scene, rasty, converter, converting_during_runtime);
+  }
+
+  BLI_task_parallel_range(0, conversions.size(), &data, bl_mesh_conversion_geometry_task, &settings);
+
+  for (BL_MeshConversion &conv : conversions) {
+    bl_mesh_conversion_end(conv, converter, libloading);
+  }
+}
+
 //////////////////////////////////////////////////////
 static void BL_CreatePhysicsObjectNew(KX_GameObject *gameobj,
                                       struct Object *blenderobject,
@@ -1145,6 +1301,21 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
   /* Ensure objects base flags are up to date each time we call BL_ConvertObjects */
   BKE_scene_set_background(maggie, blenderscene);
 
+  if (!single_object) {
+    // Convert the meshes of the scene objects at once to share the work between threads.
+    std::vector<Object *> meshobjects;
+    for (SETLOOPER(blenderscene, sce_iter, base)) {
+      Object *blenderobject = base->object;
+      if (blenderobject->type == OB_MESH && blenderobject != kxscene->GetGameDefaultCamera()) {
+        // The light layer used by the materials is computed as in the objects conversion.
+        blenderobject->lay = (blenderobject->base_flag &
+                              (BASE_VISIBLE_VIEWLAYER | BASE_VISIBLE_DEPSGRAPH)) != 0;
+        meshobjects.push_back(blenderobject);
+      }
+    }
+    bl_ConvertMeshes(meshobjects, kxscene, rendertools, converter, libloading, false);
+  }
+
   // Let's support scene set.
   // Beware of name conflict in linked data, it will not crash but will create confusion
   // in Python scripting and in certain actuators (replace mesh). Linked scene *should* have
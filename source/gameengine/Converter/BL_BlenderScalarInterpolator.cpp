@@ -31,16 +31,107 @@
 
 #include "BL_BlenderScalarInterpolator.h"
 
+#include <algorithm>
+#include <cmath>
 #include <stdio.h>
 #include <string.h>
 
 #include "BKE_fcurve.h"
 #include "DNA_anim_types.h"
+#include "DNA_curve_types.h"
+
+/// Maximum number of samples per F-curve.
+static const unsigned int maxSampleCount = 1 << 16;
+/// Finest frame step tried to sample a F-curve.
+static const float minSampleStep = 1.0f / 16.0f;
+
+float BL_InterpolatorList::m_sampleTolerance = 0.0f;
+
+BL_ScalarInterpolator::BL_ScalarInterpolator(FCurve *fcu, float tolerance)
+    : m_fcu(fcu), m_startFrame(0.0f), m_endFrame(0.0f), m_sampleRate(0.0f)
+{
+  if (tolerance > 0.0f) {
+    Sample(tolerance);
+  }
+}
+
+void BL_ScalarInterpolator::Sample(float tolerance)
+{
+  /* Modifiers and drivers can depend on other data than the frame and constant keyframes
+   * can't be interpolated, keep evaluating these F-curves. */
+  if (!m_fcu->bezt || m_fcu->totvert < 2 || m_fcu->modifiers.first || m_fcu->driver) {
+    return;
+  }
+  for (unsigned int i = 0; i < m_fcu->totvert; ++i) {
+    if (m_fcu->bezt[i].ipo == BEZT_IPO_CONST) {
+      return;
+    }
+  }
+
+  const float start = m_fcu->bezt[0].vec[1][0];
+  const float end = m_fcu->bezt[m_fcu->totvert - 1].vec[1][0];
+  if (end <= start) {
+    return;
+  }
+
+  /* The tolerance is relative to the value range of the control points, which contains the
+   * whole curve between the first and last keyframe. */
+  float minValue = m_fcu->bezt[0].vec[1][1];
+  float maxValue = minValue;
+  for (unsigned int i = 0; i < m_fcu->totvert; ++i) {
+    for (unsigned short j = 0; j < 3; ++j) {
+      minValue = std::min(minValue, m_fcu->bezt[i].vec[j][1]);
+      maxValue = std::max(maxValue, m_fcu->bezt[i].vec[j][1]);
+    }
+  }
+  const float absTolerance = tolerance * (maxValue - minValue);
+
+  // Refine the step until the middle of each sample interval is in the tolerance.
+  for (float step = 1.0f; step >= minSampleStep; step *= 0.5f) {
+    const unsigned int count = (unsigned int)ceilf((end - start) / step) + 1;
+    if (count > maxSampleCount) {
+      break;
+    }
+
+    // Spread the samples to match exactly the first and last keyframe.
+    const float realStep = (end - start) / (count - 1);
+    m_samples.resize(count);
+    m_samples[0] = evaluate_fcurve(m_fcu, start);
+
+    // Stop at the first interval out of the tolerance to try directly a finer step.
+    bool valid = true;
+    for (unsigned int i = 1; i < count && valid; ++i) {
+      m_samples[i] = evaluate_fcurve(m_fcu, start + realStep * i);
+      const float middle = evaluate_fcurve(m_fcu, start + realStep * (i - 0.5f));
+      valid = (fabsf(middle - (m_samples[i - 1] + m_samples[i]) * 0.5f) <= absTolerance);
+    }
+
+    if (valid) {
+      m_startFrame = start;
+      m_endFrame = end;
+      m_sampleRate = 1.0f / realStep;
+      m_samples.shrink_to_fit();
+      return;
+    }
+  }
+
+  m_samples.clear();
+  m_samples.shrink_to_fit();
+}
 
 float BL_ScalarInterpolator::GetValue(float currentTime) const
 {
-  // XXX 2.4x IPO_GetFloatValue(m_blender_adt, m_channel, currentTime);
-  return evaluate_fcurve(m_fcu, currentTime);
+  // Outside of the keyframes the F-curve extrapolation is used.
+  if (m_samples.empty() || currentTime < m_startFrame || currentTime > m_endFrame) {
+    // XXX 2.4x IPO_GetFloatValue(m_blender_adt, m_channel, currentTime);
+    return evaluate_fcurve(m_fcu, currentTime);
+  }
+
+  const float position = (currentTime - m_startFrame) * m_sampleRate;
+  const unsigned int index = std::min((unsigned int)position, (unsigned int)m_samples.size() - 2);
+  const float factor = position - index;
+
+  return m_samples[index] + (m_samples[index + 1] - m_samples[index]) * factor;
 }
 
 BL_InterpolatorList::BL_InterpolatorList(bAction *action) : m_action(action)
@@ -50,7 +141,7 @@ BL_InterpolatorList::BL_InterpolatorList(bAction *action) : m_action(action)
 
   for (FCurve *fcu = (FCurve *)action->curves.first; fcu; fcu = fcu->next) {
     if (fcu->rna_path) {
-      BL_ScalarInterpolator *new_ipo = new BL_ScalarInterpolator(fcu);
+      BL_ScalarInterpolator *new_ipo = new BL_ScalarInterpolator(fcu, m_sampleTolerance);
       // assert(new_ipo);
       m_interpolators.push_back(new_ipo);
     }
@@ -79,3 +170,13 @@ BL_ScalarInterpolator *BL_InterpolatorList::GetScalarInterpolator(const char *rn
   }
   return nullptr;
 }
+
+void BL_InterpolatorList::SetSampleTolerance(float tolerance)
+{
+  m_sampleTolerance = tolerance;
+}
+
+float BL_InterpolatorList::GetSampleTolerance()
+{
+  return m_sampleTolerance;
+}
@@ -40,14 +40,16 @@ struct bAction;
 
 typedef unsigned short BL_IpoChannel;
 
+/** \brief Interpolator of a F-curve.
+ * The F-curve is sampled at construction in evenly spaced values interpolated linearly when the
+ * samples are close enough to the F-curve, it avoids the Bezier evaluation at each frame.
+ */
 class BL_ScalarInterpolator : public KX_IScalarInterpolator {
  public:
   BL_ScalarInterpolator()
   {
   }  // required for use in STL list
-  BL_ScalarInterpolator(struct FCurve *fcu) : m_fcu(fcu)
-  {
-  }
+  BL_ScalarInterpolator(struct FCurve *fcu, float tolerance);
 
   virtual ~BL_ScalarInterpolator()
   {
@@ -61,6 +63,19 @@ class BL_ScalarInterpolator : public KX_IScalarInterpolator {
 
  private:
   struct FCurve *m_fcu;
+
+  /// Evenly spaced values of the F-curve between its first and last keyframe, can be empty.
+  std::vector<float> m_samples;
+  float m_startFrame;
+  float m_endFrame;
+  /// Inverse of the frame step between two samples.
+  float m_sampleRate;
+
+  /** Sample the F-curve if all the values interpolated from the samples are in the tolerance.
+   * \param tolerance Maximum difference between the F-curve and the interpolated samples,
+   * relative to the value range of the F-curve.
+   */
+  void Sample(float tolerance);
 };
 
 class BL_InterpolatorList {
@@ -68,6 +83,9 @@ class BL_InterpolatorList {
   bAction *m_action;
   std::vector<BL_ScalarInterpolator *> m_interpolators;
 
+  /// Tolerance used to sample the F-curves of the new interpolator lists.
+  static float m_sampleTolerance;
+
  public:
   BL_InterpolatorList(struct bAction *action);
   ~BL_InterpolatorList();
@@ -75,5 +93,10 @@ class BL_InterpolatorList {
   bAction *GetAction() const;
 
   BL_ScalarInterpolator *GetScalarInterpolator(const char *rna_path, int array_index);
-};
 
+  /** Set the relative tolerance used to sample the F-curves of the actions converted later,
+   * zero disables the sampling and is the default.
+   */
+  static void SetSampleTolerance(float tolerance);
+  static float GetSampleTolerance();
+};
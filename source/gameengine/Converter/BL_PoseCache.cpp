@@ -0,0 +1,232 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/BL_PoseCache.cpp
+ *  \ingroup bgeconv
+ */
+
+#include "BL_PoseCache.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "BKE_action.h"
+#include "BKE_animsys.h"
+#include "BLI_string.h"
+#include "DNA_action_types.h"
+#include "DNA_anim_types.h"
+#include "DNA_object_types.h"
+#include "MEM_guardedalloc.h"
+#include "RNA_access.h"
+
+static const char *poseBonesPrefix = "pose.bones[";
+
+BL_PoseCache::BL_PoseCache() : m_frameStep(0.0f)
+{
+}
+
+BL_PoseCache::~BL_PoseCache()
+{
+}
+
+const BL_PoseCache::ActionInfo &BL_PoseCache::GetActionInfo(bAction *action)
+{
+  std::map<bAction *, ActionInfo>::iterator it = m_actions.find(action);
+  if (it != m_actions.end()) {
+    return it->second;
+  }
+
+  ActionInfo &info = m_actions[action];
+  info.m_cacheable = true;
+
+  for (FCurve *fcu = (FCurve *)action->curves.first; fcu; fcu = fcu->next) {
+    const char *path = fcu->rna_path;
+    // Only the transforms of the pose channels can be copied between armatures.
+    const char *prop = path ? strstr(path, "\"].") : nullptr;
+    char *name = (prop && STRPREFIX(path, poseBonesPrefix)) ?
+                     BLI_str_quoted_substrN(path, poseBonesPrefix) :
+                     nullptr;
+    if (!name) {
+      info.m_cacheable = false;
+      break;
+    }
+
+    prop += 3;
+    int offset = -1;
+    int length = 0;
+    if (STREQ(prop, "location")) {
+      offset = 0;
+      length = 3;
+    }
+    else if (STREQ(prop, "rotation_quaternion")) {
+      offset = 3;
+      length = 4;
+    }
+    else if (STREQ(prop, "rotation_euler")) {
+      offset = 7;
+      length = 3;
+    }
+    else if (STREQ(prop, "rotation_axis_angle")) {
+      offset = 10;
+      length = 4;
+    }
+    else if (STREQ(prop, "scale")) {
+      offset = 14;
+      length = 3;
+    }
+
+    if (offset == -1 || fcu->array_index < 0 || fcu->array_index >= length) {
+      MEM_freeN(name);
+      info.m_cacheable = false;
+      break;
+    }
+
+    const unsigned int component = (1 << (offset + fcu->array_index));
+    // The F-curves of a channel are usually consecutive.
+    if (!info.m_channels.empty() && info.m_channels.back().m_name == name) {
+      info.m_channels.back().m_components |= component;
+    }
+    else {
+      bool found = false;
+      for (AnimatedChannel &channel : info.m_channels) {
+        if (channel.m_name == name) {
+          channel.m_components |= component;
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        info.m_channels.push_back({name, component});
+      }
+    }
+    MEM_freeN(name);
+  }
+
+  if (!info.m_cacheable) {
+    info.m_channels.clear();
+  }
+
+  return info;
+}
+
+float &BL_PoseCache::GetChannelComponent(bPoseChannel *pchan, unsigned short index)
+{
+  if (index < 3) {
+    return pchan->loc[index];
+  }
+  else if (index < 7) {
+    return pchan->quat[index - 3];
+  }
+  else if (index < 10) {
+    return pchan->eul[index - 7];
+  }
+  // RNA axis angle is the angle followed by the axis.
+  else if (index == 10) {
+    return pchan->rotAngle;
+  }
+  else if (index < 14) {
+    return pchan->rotAxis[index - 11];
+  }
+  return pchan->size[index - 14];
+}
+
+void BL_PoseCache::EvaluateAction(Object *ob, bAction *action, const AnimationEvalContext *evalCtx)
+{
+  const ActionInfo &info = GetActionInfo(action);
+
+  if (!info.m_cacheable) {
+    PointerRNA ptrrna;
+    RNA_id_pointer_create(&ob->id, &ptrrna);
+    animsys_evaluate_action(&ptrrna, action, evalCtx, false);
+    return;
+  }
+
+  const float frame = (m_frameStep > 0.0f) ?
+                          roundf(evalCtx->eval_time / m_frameStep) * m_frameStep :
+                          evalCtx->eval_time;
+  const PoseKey key(action, ob->data, frame);
+
+  std::map<PoseKey, std::vector<ChannelTransform>>::iterator it = m_poses.find(key);
+  if (it == m_poses.end()) {
+    const AnimationEvalContext frameEvalCtx = BKE_animsys_eval_context_construct_at(evalCtx,
+                                                                                    frame);
+    PointerRNA ptrrna;
+    RNA_id_pointer_create(&ob->id, &ptrrna);
+    animsys_evaluate_action(&ptrrna, action, &frameEvalCtx, false);
+
+    // Store the evaluated transforms for the next armatures.
+    std::vector<ChannelTransform> &transforms = m_poses[key];
+    transforms.resize(info.m_channels.size());
+    for (unsigned int i = 0, size = info.m_channels.size(); i < size; ++i) {
+      ChannelTransform &transform = transforms[i];
+      bPoseChannel *pchan = BKE_pose_channel_find_name(ob->pose,
+                                                       info.m_channels[i].m_name.c_str());
+      transform.m_valid = (pchan != nullptr);
+      if (pchan) {
+        for (unsigned short j = 0; j < ChannelComponentCount; ++j) {
+          transform.m_components[j] = GetChannelComponent(pchan, j);
+        }
+      }
+    }
+    return;
+  }
+
+  // Copy only the animated components as the action evaluation would.
+  const std::vector<ChannelTransform> &transforms = it->second;
+  for (unsigned int i = 0, size = info.m_channels.size(); i < size; ++i) {
+    const ChannelTransform &transform = transforms[i];
+    if (!transform.m_valid) {
+      continue;
+    }
+
+    const AnimatedChannel &channel = info.m_channels[i];
+    bPoseChannel *pchan = BKE_pose_channel_find_name(ob->pose, channel.m_name.c_str());
+    if (!pchan) {
+      continue;
+    }
+
+    for (unsigned short j = 0; j < ChannelComponentCount; ++j) {
+      if (channel.m_components & (1 << j)) {
+        GetChannelComponent(pchan, j) = transform.m_components[j];
+      }
+    }
+  }
+}
+
+void BL_PoseCache::Clear()
+{
+  m_poses.clear();
+}
+
+void BL_PoseCache::ClearActions()
+{
+  m_actions.clear();
+  m_poses.clear();
+}
+
+float BL_PoseCache::GetFrameStep() const
+{
+  return m_frameStep;
+}
+
+void BL_PoseCache::SetFrameStep(float step)
+{
+  m_frameStep = step;
+}
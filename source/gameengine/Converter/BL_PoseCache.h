@@ -0,0 +1,101 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_PoseCache.h
+ *  \ingroup bgeconv
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+struct AnimationEvalContext;
+struct bAction;
+struct Object;
+
+/** \brief Per frame cache of the armature poses evaluated from actions.
+ * Armatures sharing the same armature data and playing the same action at the same frame get
+ * the F-curves evaluated once, the other armatures copy the animated channel transforms.
+ * The frames can be quantized so that armatures playing at close frames share a pose.
+ */
+class BL_PoseCache {
+ private:
+  /** Number of animatable transform components of a pose channel: location, quaternion,
+   * euler, axis angle and scale.
+   */
+  static const unsigned short ChannelComponentCount = 17;
+
+  /// A pose channel animated by an action.
+  struct AnimatedChannel {
+    std::string m_name;
+    /// Bit mask of the animated components.
+    unsigned int m_components;
+  };
+
+  /// Description of the channels animated by an action.
+  struct ActionInfo {
+    /// False if the action animates other data than the pose channel transforms.
+    bool m_cacheable;
+    std::vector<AnimatedChannel> m_channels;
+  };
+
+  /// Transform components of an animated channel.
+  struct ChannelTransform {
+    float m_components[ChannelComponentCount];
+    /// False if the channel doesn't exist in the armature.
+    bool m_valid;
+  };
+
+  /// Action, armature data and evaluated frame.
+  using PoseKey = std::tuple<bAction *, void *, float>;
+
+  std::map<bAction *, ActionInfo> m_actions;
+  /// Transforms of the channels of ActionInfo::m_channels for each evaluated pose.
+  std::map<PoseKey, std::vector<ChannelTransform>> m_poses;
+
+  /// Frame quantization step, zero to share only the poses at identical frames.
+  float m_frameStep;
+
+  const ActionInfo &GetActionInfo(bAction *action);
+  /// Return a transform component of a pose channel.
+  static float &GetChannelComponent(struct bPoseChannel *pchan, unsigned short index);
+
+ public:
+  BL_PoseCache();
+  ~BL_PoseCache();
+
+  /** Set the pose channels of an armature animated by an action.
+   * \param ob The armature object.
+   * \param action The action to evaluate.
+   * \param evalCtx The evaluation context at the action frame.
+   */
+  void EvaluateAction(Object *ob, bAction *action, const AnimationEvalContext *evalCtx);
+
+  /// Remove the cached poses, called once per frame.
+  void Clear();
+  /// Remove the cached poses and action channels, called when actions are freed.
+  void ClearActions();
+
+  float GetFrameStep() const;
+  void SetFrameStep(float step);
+};
@@ -26,9 +26,12 @@
 
 #include "DEV_EventConsumer.h"
 
+#include <algorithm>
 
 #include "BLI_string_utf8.h"
+#include "GHOST_IEvent.h"
 #include "GHOST_ISystem.h"
+#include "PIL_time.h"
 
 #include "DEV_InputDevice.h"
 #include "RAS_ICanvas.h"
@@ -36,8 +39,10 @@
 DEV_EventConsumer::DEV_EventConsumer(GHOST_ISystem *system,
                                      DEV_InputDevice *device,
                                      RAS_ICanvas *canvas)
-    : m_device(device), m_canvas(canvas)
+    : m_system(system), m_device(device), m_canvas(canvas)
 {
+  m_device->SetEventTime(PIL_check_seconds_timer());
+
   // Setup the default mouse position.
   int cursorx, cursory;
   system->getCursorPosition(cursorx, cursory);
@@ -89,6 +94,13 @@ void DEV_EventConsumer::HandleButtonEvent(GHOST_TEventDataPtr data, bool down)
 bool DEV_EventConsumer::processEvent(GHOST_IEvent *event)
 {
   GHOST_TEventDataPtr eventData = ((GHOST_IEvent *)event)->getData();
+
+  /* The events wait in the system queue until the next frame, date them with their arrival
+   * time converted from the GHOST clock. */
+  const double age =
+      std::max(0.0, double(m_system->getMilliSeconds()) - double(event->getTime())) * 1e-3;
+  m_device->SetEventTime(PIL_check_seconds_timer() - age);
+
   switch (event->getType()) {
     case GHOST_kEventButtonDown: {
       HandleButtonEvent(eventData, true);
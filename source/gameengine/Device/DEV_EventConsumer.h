@@ -36,6 +36,7 @@ class RAS_ICanvas;
 
 class DEV_EventConsumer : public GHOST_IEventConsumer {
  private:
+  GHOST_ISystem *m_system;
   DEV_InputDevice *m_device;
   RAS_ICanvas *m_canvas;
 
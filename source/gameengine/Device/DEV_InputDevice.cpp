@@ -199,6 +199,7 @@ void DEV_InputDevice::ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type,
                                         SCA_InputEvent::JUSTRELEASED);
     event.m_values.push_back(val);
     event.m_unicode = unicode;
+    AddEventRecord(type, val);
 
     // Avoid pushing nullptr string character.
     if (val > 0 && unicode != 0) {
@@ -209,6 +210,9 @@ void DEV_InputDevice::ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type,
 
 void DEV_InputDevice::ConvertMoveEvent(int x, int y)
 {
+  AddEventRecord(MOUSEX, x);
+  AddEventRecord(MOUSEY, y);
+
   SCA_InputEvent &xevent = m_inputsTable[MOUSEX];
   xevent.m_values.push_back(x);
   if (xevent.m_status[xevent.m_status.size() - 1] != SCA_InputEvent::ACTIVE) {
@@ -226,7 +230,10 @@ void DEV_InputDevice::ConvertMoveEvent(int x, int y)
 
 void DEV_InputDevice::ConvertWheelEvent(int z)
 {
-  SCA_InputEvent &event = m_inputsTable[(z > 0) ? WHEELUPMOUSE : WHEELDOWNMOUSE];
+  const SCA_EnumInputs type = (z > 0) ? WHEELUPMOUSE : WHEELDOWNMOUSE;
+  AddEventRecord(type, z);
+
+  SCA_InputEvent &event = m_inputsTable[type];
   event.m_values.push_back(z);
   if (event.m_status[event.m_status.size() - 1] != SCA_InputEvent::ACTIVE) {
     event.m_status.push_back(SCA_InputEvent::ACTIVE);
@@ -21,6 +21,8 @@
 
 #include "EXP_Value.h"
 
+#include <unordered_map>
+
 class CBaseListValue : public CPropValue {
   Py_Header
 
@@ -33,6 +35,19 @@ class CBaseListValue : public CPropValue {
   VectorType m_pValueArray;
   bool m_bReleaseContents;
 
+  /** Index of the first value of each name, built lazily by FindValue and invalidated by any
+   * modification of the list or rename of a value. While valid every value of the list is
+   * registered in CValue::m_nameIndexLists to notify the list of its rename or deletion.
+   */
+  mutable std::unordered_map<std::string, CValue *> m_nameIndex;
+  mutable bool m_nameIndexValid;
+  /// Number of name searches since the last invalidation of the index.
+  mutable unsigned short m_nameSearchCount;
+
+  /// Unregister the values and clear the index, must be called before modifying the values.
+  void InvalidateNameIndex();
+  void UnregisterNameIndexValue(CValue *value);
+
   void SetValue(int i, CValue *val);
   CValue *GetValue(int i);
   CValue *FindValue(const std::string &name) const;
@@ -42,8 +57,12 @@ class CBaseListValue : public CPropValue {
   bool RemoveValue(CValue *val);
   bool CheckEqual(CValue *first, CValue *second);
 
+  friend class CValue;
+
  public:
   CBaseListValue();
+  /// The copy does not share the name index of the original list.
+  CBaseListValue(const CBaseListValue &other);
   virtual ~CBaseListValue();
 
   virtual int GetValueType();
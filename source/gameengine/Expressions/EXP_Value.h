@@ -73,6 +73,8 @@ enum VALUE_DATA_TYPE {
 #  include "object.h"
 #endif
 
+class CBaseListValue;
+
 /**
  * Baseclass CValue
  *
@@ -174,10 +176,27 @@ class CValue : public PyObjectPlus, public CM_RefCount<CValue> {
  protected:
   virtual void DestructFromPython();
 
+  /** Must be called by SetName implementations when the name changes, invalidate the name
+   * index of the lists containing this value.
+   */
+  void NameChanged()
+  {
+    InvalidateListNameIndices();
+  }
+
  private:
+  friend class CBaseListValue;
+
+  void InvalidateListNameIndices();
+
   /// Properties for user/game etc.
   std::map<std::string, CValue *> *m_pNamedPropertyArray;
   bool m_error;
+
+  /** Lists with a valid name index containing this value, once per occurrence of the value
+   * in the list. Only accessed by the thread owning the lists.
+   */
+  std::vector<CBaseListValue *> m_nameIndexLists;
 };
 
 /** CPropValue is a CValue derived class, that implements the identification (String name)
@@ -196,7 +215,10 @@ class CPropValue : public CValue {
 
   virtual void SetName(const std::string &name)
   {
-    m_strNewName = name;
+    if (name != m_strNewName) {
+      m_strNewName = name;
+      NameChanged();
+    }
   }
 
   virtual std::string GetName()
@@ -23,12 +23,27 @@
 
 
 
-CBaseListValue::CBaseListValue() : m_bReleaseContents(true)
+/// Lists smaller than this are always searched linearly.
+static const unsigned int nameIndexMinSize = 32;
+
+CBaseListValue::CBaseListValue()
+    : m_bReleaseContents(true), m_nameIndexValid(false), m_nameSearchCount(0)
+{
+}
+
+CBaseListValue::CBaseListValue(const CBaseListValue &other)
+    : CPropValue(other),
+      m_pValueArray(other.m_pValueArray),
+      m_bReleaseContents(other.m_bReleaseContents),
+      m_nameIndexValid(false),
+      m_nameSearchCount(0)
 {
 }
 
 CBaseListValue::~CBaseListValue()
 {
+  InvalidateNameIndex();
+
   if (m_bReleaseContents) {
     for (CValue *item : m_pValueArray) {
       item->Release();
@@ -36,8 +51,31 @@ CBaseListValue::~CBaseListValue()
   }
 }
 
+void CBaseListValue::InvalidateNameIndex()
+{
+  if (m_nameIndexValid) {
+    for (CValue *item : m_pValueArray) {
+      UnregisterNameIndexValue(item);
+    }
+    m_nameIndex.clear();
+    m_nameIndexValid = false;
+  }
+  m_nameSearchCount = 0;
+}
+
+void CBaseListValue::UnregisterNameIndexValue(CValue *value)
+{
+  std::vector<CBaseListValue *> &lists = value->m_nameIndexLists;
+  const std::vector<CBaseListValue *>::iterator it = std::find(lists.begin(), lists.end(), this);
+  if (it != lists.end()) {
+    *it = lists.back();
+    lists.pop_back();
+  }
+}
+
 void CBaseListValue::SetValue(int i, CValue *val)
 {
+  InvalidateNameIndex();
   m_pValueArray[i] = val;
 }
 
@@ -48,6 +86,24 @@ CValue *CBaseListValue::GetValue(int i)
 
 CValue *CBaseListValue::FindValue(const std::string &name) const
 {
+  /* Small lists or lists modified between each search are faster to scan, the index is
+   * only built from the second search on an unmodified list. */
+  if (!m_nameIndexValid && m_pValueArray.size() >= nameIndexMinSize && ++m_nameSearchCount > 1) {
+    m_nameIndex.reserve(m_pValueArray.size());
+    CBaseListValue *self = const_cast<CBaseListValue *>(this);
+    for (CValue *item : m_pValueArray) {
+      // Keep the first value of a name like the linear search.
+      m_nameIndex.emplace(item->GetName(), item);
+      item->m_nameIndexLists.push_back(self);
+    }
+    m_nameIndexValid = true;
+  }
+
+  if (m_nameIndexValid) {
+    const std::unordered_map<std::string, CValue *>::const_iterator it = m_nameIndex.find(name);
+    return (it != m_nameIndex.end()) ? it->second : nullptr;
+  }
+
   const VectorTypeConstIterator it = std::find_if(
       m_pValueArray.begin(), m_pValueArray.end(), [&name](CValue *item) {
         return item->GetName() == name;
@@ -71,10 +127,16 @@ bool CBaseListValue::SearchValue(CValue *val) const
 void CBaseListValue::Add(CValue *value)
 {
   m_pValueArray.push_back(value);
+  // An appended value is only indexed if its name is not already used.
+  if (m_nameIndexValid) {
+    m_nameIndex.emplace(value->GetName(), value);
+    value->m_nameIndexLists.push_back(this);
+  }
 }
 
 void CBaseListValue::Insert(unsigned int i, CValue *value)
 {
+  InvalidateNameIndex();
   m_pValueArray.insert(m_pValueArray.begin() + i, value);
 }
 
@@ -84,12 +146,36 @@ bool CBaseListValue::RemoveValue(CValue *val)
   for (VectorTypeIterator it = m_pValueArray.begin(); it != m_pValueArray.end();) {
     if (*it == val) {
       it = m_pValueArray.erase(it);
+      if (m_nameIndexValid) {
+        UnregisterNameIndexValue(val);
+      }
       result = true;
     }
     else {
       ++it;
     }
   }
+
+  if (result && m_nameIndexValid) {
+    /* Update the index entry of the removed value, a value deleted while in the list
+     * invalidates the index so the value is still alive here. */
+    std::unordered_map<std::string, CValue *>::iterator it = m_nameIndex.find(val->GetName());
+    if (it != m_nameIndex.end() && it->second == val) {
+      const std::string &name = it->first;
+      // Fallback to the next value using the same name.
+      const VectorTypeConstIterator next = std::find_if(
+          m_pValueArray.begin(), m_pValueArray.end(), [&name](CValue *item) {
+            return item->GetName() == name;
+          });
+      if (next != m_pValueArray.end()) {
+        it->second = *next;
+      }
+      else {
+        m_nameIndex.erase(it);
+      }
+    }
+  }
+
   return result;
 }
 
@@ -135,16 +221,19 @@ void CBaseListValue::SetReleaseOnDestruct(bool bReleaseContents)
 
 void CBaseListValue::Remove(int i)
 {
+  InvalidateNameIndex();
   m_pValueArray.erase(m_pValueArray.begin() + i);
 }
 
 void CBaseListValue::Resize(int num)
 {
+  InvalidateNameIndex();
   m_pValueArray.resize(num);
 }
 
 void CBaseListValue::ReleaseAndRemoveAll()
 {
+  InvalidateNameIndex();
   for (CValue *item : m_pValueArray) {
     item->Release();
   }
@@ -473,6 +562,7 @@ PyObject *CBaseListValue::Pyreverse()
   }
 
   std::reverse(m_pValueArray.begin(), m_pValueArray.end());
+  InvalidateNameIndex();
   Py_RETURN_NONE;
 }
 
@@ -35,7 +35,7 @@ CBoolValue::CBoolValue(bool inBool) : m_bool(inBool)
 
 CBoolValue::CBoolValue(bool innie, const std::string &name) : m_bool(innie)
 {
-  SetName(name);
+  m_strNewName = name;
 }
 
 void CBoolValue::SetValue(CValue *newval)
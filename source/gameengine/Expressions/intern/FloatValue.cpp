@@ -33,7 +33,7 @@ CFloatValue::CFloatValue(float fl) : m_float(fl)
 
 CFloatValue::CFloatValue(float fl, const std::string &name) : m_float(fl)
 {
-  SetName(name);
+  m_strNewName = name;
 }
 
 CFloatValue::~CFloatValue()
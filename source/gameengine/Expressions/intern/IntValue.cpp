@@ -35,7 +35,7 @@ CIntValue::CIntValue(cInt innie) : m_int(innie)
 
 CIntValue::CIntValue(cInt innie, const std::string &name) : m_int(innie)
 {
-  SetName(name);
+  m_strNewName = name;
 }
 
 CIntValue::~CIntValue()
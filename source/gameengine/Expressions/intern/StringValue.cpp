@@ -26,7 +26,7 @@ CStringValue::CStringValue() : m_strString("[Illegal String constructor call]")
 
 CStringValue::CStringValue(const std::string &txt, const std::string &name) : m_strString(txt)
 {
-  SetName(name);
+  m_strNewName = name;
 }
 
 CValue *CStringValue::Calc(VALUE_OPERATOR op, CValue *val)
@@ -20,6 +20,7 @@
 
 #include "EXP_Value.h"
 
+#include "EXP_BaseListValue.h"
 #include "EXP_BoolValue.h"
 #include "EXP_ErrorValue.h"
 #include "EXP_FloatValue.h"
@@ -77,9 +78,20 @@ CValue::CValue() : m_pNamedPropertyArray(nullptr), m_error(false)
 
 CValue::~CValue()
 {
+  InvalidateListNameIndices();
   ClearProperties();
 }
 
+void CValue::InvalidateListNameIndices()
+{
+  // The lists unregister this value from the vector while invalidating their index.
+  const std::vector<CBaseListValue *> lists = std::move(m_nameIndexLists);
+  m_nameIndexLists.clear();
+  for (CBaseListValue *list : lists) {
+    list->InvalidateNameIndex();
+  }
+}
+
 std::string CValue::op2str(VALUE_OPERATOR op)
 {
   std::string opmsg;
@@ -302,6 +314,9 @@ void CValue::ProcessReplica()
 {
   PyObjectPlus::ProcessReplica();
 
+  // The replica is not contained in any list.
+  m_nameIndexLists.clear();
+
   // Copy all props.
   if (m_pNamedPropertyArray) {
     std::map<std::string, CValue *> *pOldArray = m_pNamedPropertyArray;
@@ -0,0 +1,210 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "EXP_PyObjectPlus.h"
+
+#include "PIL_time.h"
+
+#define NUM_RUN_AVERAGED 10
+#define NUM_ACCESS 1000000
+
+/** Measure the python attribute reads and writes of PyObjectPlus proxies through the generic
+ * py_get_attrdef/py_set_attrdef getsets, the path of every attribute of the game engine types.
+ *
+ * The "direct" attribute is the same function attribute behind getsets calling directly the
+ * attribute functions, it gives the cost of the generic attribute type dispatch.
+ */
+
+class PerfObject : public PyObjectPlus {
+  Py_Header
+
+ public:
+  float m_value;
+
+  PerfObject() : m_value(0.0f)
+  {
+  }
+
+  static PyObject *pyattr_get_value(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef)
+  {
+    return PyFloat_FromDouble(static_cast<PerfObject *>(self_v)->m_value);
+  }
+
+  static int pyattr_set_value(PyObjectPlus *self_v,
+                              const KX_PYATTRIBUTE_DEF *attrdef,
+                              PyObject *value)
+  {
+    const double val = PyFloat_AsDouble(value);
+    if (val == -1.0 && PyErr_Occurred()) {
+      return PY_SET_ATTR_FAIL;
+    }
+    static_cast<PerfObject *>(self_v)->m_value = val;
+    return PY_SET_ATTR_SUCCESS;
+  }
+};
+
+PyTypeObject PerfObject::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "PerfObject",
+                                 sizeof(PyObjectPlus_Proxy),
+                                 0,
+                                 py_base_dealloc,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 py_base_repr,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 Methods,
+                                 0,
+                                 0,
+                                 &PyObjectPlus::Type,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 py_base_new};
+
+PyMethodDef PerfObject::Methods[] = {
+    {nullptr, nullptr}  // Sentinel
+};
+
+PyAttributeDef PerfObject::Attributes[] = {
+    KX_PYATTRIBUTE_RW_FUNCTION("value", PerfObject, pyattr_get_value, pyattr_set_value),
+    KX_PYATTRIBUTE_RW_FUNCTION("direct", PerfObject, pyattr_get_value, pyattr_set_value),
+    KX_PYATTRIBUTE_FLOAT_RW("field", -FLT_MAX, FLT_MAX, PerfObject, m_value),
+    KX_PYATTRIBUTE_NULL  // Sentinel
+};
+
+static PyObject *perf_get_direct(PyObject *self_py, const PyAttributeDef *attrdef)
+{
+  PyObjectPlus *ref = BGE_PROXY_REF(self_py);
+  if (ref == nullptr || !ref->py_is_valid()) {
+    PyErr_SetString(PyExc_SystemError, BGE_PROXY_ERROR_MSG);
+    return nullptr;
+  }
+  return (*attrdef->m_getFunction)(ref, attrdef);
+}
+
+static int perf_set_direct(PyObject *self_py, PyObject *value, const PyAttributeDef *attrdef)
+{
+  PyObjectPlus *ref = BGE_PROXY_REF(self_py);
+  if (ref == nullptr || !ref->py_is_valid()) {
+    PyErr_SetString(PyExc_SystemError, BGE_PROXY_ERROR_MSG);
+    return PY_SET_ATTR_FAIL;
+  }
+  return (*attrdef->m_setFunction)(ref, attrdef, value);
+}
+
+/// Same getsets as the ones created in KX_PythonInitTypes.cpp.
+static void perf_type_ready()
+{
+  static PyGetSetDef getset[ARRAY_SIZE(PerfObject::Attributes)] = {{nullptr}};
+  if (PerfObject::Type.tp_getset) {
+    return;
+  }
+
+  for (unsigned int i = 0; !PerfObject::Attributes[i].m_name.empty(); ++i) {
+    PyAttributeDef *attr = &PerfObject::Attributes[i];
+    const bool direct = (attr->m_name == "direct");
+    attr->m_usePtr = false;
+    getset[i].name = (char *)attr->m_name.c_str();
+    getset[i].get = direct ? reinterpret_cast<getter>(perf_get_direct) :
+                             reinterpret_cast<getter>(PyObjectPlus::py_get_attrdef);
+    getset[i].set = direct ? reinterpret_cast<setter>(perf_set_direct) :
+                             reinterpret_cast<setter>(PyObjectPlus::py_set_attrdef);
+    getset[i].closure = reinterpret_cast<void *>(attr);
+  }
+
+  PerfObject::Type.tp_getset = getset;
+  PyType_Ready(&PyObjectPlus::Type);
+  PyType_Ready(&PerfObject::Type);
+}
+
+static void attribute_access_test(const char *attrname, bool write)
+{
+  if (!Py_IsInitialized()) {
+    Py_Initialize();
+  }
+  perf_type_ready();
+
+  PerfObject *object = new PerfObject();
+  PyObject *proxy = object->GetProxy();
+  PyObject *name = PyUnicode_InternFromString(attrname);
+  PyObject *value = PyFloat_FromDouble(1.0);
+
+  double averaged_timing = 0.0;
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    const double init_time = PIL_check_seconds_timer();
+    for (int j = 0; j < NUM_ACCESS; j++) {
+      if (write) {
+        PyObject_SetAttr(proxy, name, value);
+      }
+      else {
+        Py_DECREF(PyObject_GetAttr(proxy, name));
+      }
+    }
+    averaged_timing += PIL_check_seconds_timer() - init_time;
+  }
+
+  printf("%s.%s %s: %.2fns per access on average over %d runs\n",
+         PerfObject::Type.tp_name,
+         attrname,
+         write ? "write" : "read",
+         averaged_timing / NUM_RUN_AVERAGED / NUM_ACCESS * 1.0e9,
+         NUM_RUN_AVERAGED);
+
+  EXPECT_EQ(object->m_value, write ? 1.0f : 0.0f);
+
+  Py_DECREF(value);
+  Py_DECREF(name);
+  Py_DECREF(proxy);
+  delete object;
+}
+
+TEST(pyobjectplus, FunctionAttributeRead)
+{
+  attribute_access_test("value", false);
+}
+
+TEST(pyobjectplus, FunctionAttributeReadDirect)
+{
+  attribute_access_test("direct", false);
+}
+
+TEST(pyobjectplus, FieldAttributeRead)
+{
+  attribute_access_test("field", false);
+}
+
+TEST(pyobjectplus, FunctionAttributeWrite)
+{
+  attribute_access_test("value", true);
+}
+
+TEST(pyobjectplus, FunctionAttributeWriteDirect)
+{
+  attribute_access_test("direct", true);
+}
+
+TEST(pyobjectplus, FieldAttributeWrite)
+{
+  attribute_access_test("field", true);
+}
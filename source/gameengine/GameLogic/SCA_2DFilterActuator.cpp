@@ -47,11 +47,12 @@ SCA_2DFilterActuator::SCA_2DFilterActuator(SCA_IObject *gameobj,
       m_float_arg(float_arg),
       m_int_arg(int_arg),
       m_mipmap(mipmap),
+      m_shaderText(std::make_shared<const std::string>()),
       m_rasterizer(rasterizer),
       m_filterManager(filterManager),
       m_scene(scene)
 {
-  m_propNames = m_gameobj->GetPropertyNames();
+  m_propNames = std::make_shared<const std::vector<std::string>>(m_gameobj->GetPropertyNames());
 }
 
 SCA_2DFilterActuator::~SCA_2DFilterActuator()
@@ -103,8 +104,8 @@ bool SCA_2DFilterActuator::Update()
         info.filterPassIndex = m_int_arg;
         info.gameObject = m_gameobj;
         info.filterMode = m_type;
-        info.propertyNames = m_propNames;
-        info.shaderText = m_shaderText;
+        info.propertyNames = *m_propNames;
+        info.shaderText = *m_shaderText;
         info.mipmap = m_mipmap;
 
         m_filterManager->AddFilter(info);
@@ -129,7 +130,8 @@ void SCA_2DFilterActuator::SetScene(SCA_IScene *scene, RAS_2DFilterManager *filt
 
 void SCA_2DFilterActuator::SetShaderText(const std::string &text)
 {
-  m_shaderText = text;
+  // Replace instead of modify, the previous text can be used by other replicas.
+  m_shaderText = std::make_shared<const std::string>(text);
 }
 
 #ifdef WITH_PYTHON
@@ -183,7 +185,8 @@ PyMethodDef SCA_2DFilterActuator::Methods[] = {
     {nullptr, nullptr}};
 
 PyAttributeDef SCA_2DFilterActuator::Attributes[] = {
-    KX_PYATTRIBUTE_STRING_RW("shaderText", 0, 64000, false, SCA_2DFilterActuator, m_shaderText),
+    KX_PYATTRIBUTE_RW_FUNCTION(
+        "shaderText", SCA_2DFilterActuator, pyattr_get_shader_text, pyattr_set_shader_text),
     KX_PYATTRIBUTE_SHORT_RW(
         "disableMotionBlur", 0, 1, true, SCA_2DFilterActuator, m_disableMotionBlur),
     KX_PYATTRIBUTE_ENUM_RW("mode",
@@ -197,4 +200,41 @@ PyAttributeDef SCA_2DFilterActuator::Attributes[] = {
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
+PyObject *SCA_2DFilterActuator::pyattr_get_shader_text(PyObjectPlus *self_v,
+                                                       const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  SCA_2DFilterActuator *self = static_cast<SCA_2DFilterActuator *>(self_v);
+  return PyUnicode_FromStdString(*self->m_shaderText);
+}
+
+int SCA_2DFilterActuator::pyattr_set_shader_text(PyObjectPlus *self_v,
+                                                 const KX_PYATTRIBUTE_DEF *attrdef,
+                                                 PyObject *value)
+{
+  SCA_2DFilterActuator *self = static_cast<SCA_2DFilterActuator *>(self_v);
+
+  if (!PyUnicode_Check(value)) {
+    PyErr_Format(
+        PyExc_TypeError, "expected a string for attribute \"%s\"", attrdef->m_name.c_str());
+    return PY_SET_ATTR_FAIL;
+  }
+
+  const char *str = _PyUnicode_AsString(value);
+  if (!str) {
+    return PY_SET_ATTR_FAIL;
+  }
+
+  const std::string text = str;
+  if (text.size() > 64000) {
+    PyErr_Format(PyExc_ValueError,
+                 "string length out of range for attribute \"%s\"",
+                 attrdef->m_name.c_str());
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetShaderText(text);
+
+  return PY_SET_ATTR_SUCCESS;
+}
+
 #endif
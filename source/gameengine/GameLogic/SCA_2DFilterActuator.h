@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include <memory>
 
 #include "RAS_Rasterizer.h"
 #include "SCA_IActuator.h"
@@ -40,14 +41,15 @@ class RAS_2DFilterManager;
 class SCA_2DFilterActuator : public SCA_IActuator {
   Py_Header
 
-      private : std::vector<std::string>
-                    m_propNames;
+ private:
+  /// Property names and shader text, immutable and shared between the replicas.
+  std::shared_ptr<const std::vector<std::string>> m_propNames;
   int m_type;
   short m_disableMotionBlur;
   float m_float_arg;
   int m_int_arg;
   bool m_mipmap;
-  std::string m_shaderText;
+  std::shared_ptr<const std::string> m_shaderText;
   RAS_Rasterizer *m_rasterizer;
   RAS_2DFilterManager *m_filterManager;
   SCA_IScene *m_scene;
@@ -70,4 +72,12 @@ class SCA_2DFilterActuator : public SCA_IActuator {
   void SetScene(SCA_IScene *scene, RAS_2DFilterManager *filterManager);
 
   virtual CValue *GetReplica();
+
+#ifdef WITH_PYTHON
+  static PyObject *pyattr_get_shader_text(PyObjectPlus *self_v,
+                                          const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_shader_text(PyObjectPlus *self_v,
+                                    const KX_PYATTRIBUTE_DEF *attrdef,
+                                    PyObject *value);
+#endif
 };
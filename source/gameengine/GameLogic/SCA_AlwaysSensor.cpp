@@ -76,6 +76,12 @@ bool SCA_AlwaysSensor::IsPositiveTrigger()
   return (m_invert ? false : true);
 }
 
+bool SCA_AlwaysSensor::CanSleep()
+{
+  // Only the first evaluation after the initialization triggers.
+  return !m_alwaysresult;
+}
+
 bool SCA_AlwaysSensor::Evaluate()
 {
   /* Nice! :) */
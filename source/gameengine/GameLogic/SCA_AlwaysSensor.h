@@ -47,5 +47,6 @@ class SCA_AlwaysSensor : public SCA_ISensor {
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
   virtual void Init();
+  virtual bool CanSleep();
 };
 
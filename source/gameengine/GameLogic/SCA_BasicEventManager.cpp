@@ -35,6 +35,8 @@
 
 #include "SCA_BasicEventManager.h"
 
+#include <algorithm>
+
 #include "SCA_ISensor.h"
 
 SCA_BasicEventManager::SCA_BasicEventManager(class SCA_LogicManager *logicmgr)
@@ -46,9 +48,44 @@ SCA_BasicEventManager::~SCA_BasicEventManager()
 {
 }
 
+bool SCA_BasicEventManager::RegisterSensor(SCA_ISensor *sensor)
+{
+  if (SCA_EventManager::RegisterSensor(sensor)) {
+    sensor->ClearSleeping();
+    m_awakeSensors.push_back(sensor);
+    return true;
+  }
+
+  return false;
+}
+
+bool SCA_BasicEventManager::RemoveSensor(SCA_ISensor *sensor)
+{
+  if (SCA_EventManager::RemoveSensor(sensor)) {
+    m_awakeSensors.erase(std::remove(m_awakeSensors.begin(), m_awakeSensors.end(), sensor),
+                         m_awakeSensors.end());
+    sensor->ClearSleeping();
+    return true;
+  }
+
+  return false;
+}
+
+void SCA_BasicEventManager::WakeUpSensor(SCA_ISensor *sensor)
+{
+  m_awakeSensors.push_back(sensor);
+}
+
 void SCA_BasicEventManager::NextFrame()
 {
-  for (SCA_ISensor *sensor : m_sensors) {
-    sensor->Activate(m_logicmgr);
+  // A sensor can be woken up during the loop.
+  for (unsigned int i = 0; i < m_awakeSensors.size(); ++i) {
+    m_awakeSensors[i]->Activate(m_logicmgr);
   }
+
+  // Sleeping sensors are evaluated again only once woken up.
+  m_awakeSensors.erase(std::remove_if(m_awakeSensors.begin(),
+                                      m_awakeSensors.end(),
+                                      [](SCA_ISensor *sensor) { return sensor->TrySleep(); }),
+                       m_awakeSensors.end());
 }
@@ -37,11 +37,22 @@
 
 #include "SCA_EventManager.h"
 
+/** \brief Event manager of the sensors evaluated every frame.
+ * Sensors which can't trigger anything until an external event are put to sleep and are only
+ * evaluated again once woken up, see SCA_ISensor::CanSleep.
+ */
 class SCA_BasicEventManager : public SCA_EventManager {
+ private:
+  /// Registered sensors which are not sleeping.
+  std::vector<SCA_ISensor *> m_awakeSensors;
+
  public:
   SCA_BasicEventManager(class SCA_LogicManager *logicmgr);
   ~SCA_BasicEventManager();
 
+  virtual bool RegisterSensor(SCA_ISensor *sensor);
+  virtual bool RemoveSensor(SCA_ISensor *sensor);
+  virtual void WakeUpSensor(SCA_ISensor *sensor);
   virtual void NextFrame();
 };
 
@@ -79,6 +79,12 @@ bool SCA_DelaySensor::IsPositiveTrigger()
   return (m_invert ? !m_lastResult : m_lastResult);
 }
 
+bool SCA_DelaySensor::CanSleep()
+{
+  // A delay without repeat is finished once its delay and duration are elapsed.
+  return !m_repeat && m_frameCount >= m_delay && m_frameCount >= m_delay + m_duration;
+}
+
 bool SCA_DelaySensor::Evaluate()
 {
   bool trigger = false;
@@ -168,9 +174,11 @@ PyMethodDef SCA_DelaySensor::Methods[] = {
 };
 
 PyAttributeDef SCA_DelaySensor::Attributes[] = {
-    KX_PYATTRIBUTE_INT_RW("delay", 0, 100000, true, SCA_DelaySensor, m_delay),
-    KX_PYATTRIBUTE_INT_RW("duration", 0, 100000, true, SCA_DelaySensor, m_duration),
-    KX_PYATTRIBUTE_BOOL_RW("repeat", SCA_DelaySensor, m_repeat),
+    KX_PYATTRIBUTE_INT_RW_CHECK(
+        "delay", 0, 100000, true, SCA_DelaySensor, m_delay, pyattr_check_wake_up),
+    KX_PYATTRIBUTE_INT_RW_CHECK(
+        "duration", 0, 100000, true, SCA_DelaySensor, m_duration, pyattr_check_wake_up),
+    KX_PYATTRIBUTE_BOOL_RW_CHECK("repeat", SCA_DelaySensor, m_repeat, pyattr_check_wake_up),
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
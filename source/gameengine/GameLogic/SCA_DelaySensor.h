@@ -55,6 +55,7 @@ class SCA_DelaySensor : public SCA_ISensor {
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
   virtual void Init();
+  virtual bool CanSleep();
 
   /* --------------------------------------------------------------------- */
   /* Python interface ---------------------------------------------------- */
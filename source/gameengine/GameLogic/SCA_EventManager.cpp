@@ -65,6 +65,10 @@ bool SCA_EventManager::RemoveSensor(class SCA_ISensor *sensor)
   return false;
 }
 
+void SCA_EventManager::WakeUpSensor(SCA_ISensor *sensor)
+{
+}
+
 void SCA_EventManager::NextFrame(double curtime, double fixedtime)
 {
   NextFrame();
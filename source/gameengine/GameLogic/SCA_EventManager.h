@@ -70,6 +70,8 @@ class SCA_EventManager {
   virtual void UpdateFrame();
   virtual void EndFrame();
   virtual bool RegisterSensor(class SCA_ISensor *sensor);
+  /// Evaluate again a sensor which was put to sleep by this manager.
+  virtual void WakeUpSensor(class SCA_ISensor *sensor);
   int GetType();
   // SG_DList &GetSensors() { return m_sensors; }
 
@@ -111,7 +111,7 @@ static std::map<SCA_IInputDevice::SCA_EnumInputs, std::pair<char, char>> createK
 std::map<SCA_IInputDevice::SCA_EnumInputs, std::pair<char, char>> SCA_IInputDevice::m_keyToChar =
     createKeyToCharMap();
 
-SCA_IInputDevice::SCA_IInputDevice() : m_hookExitKey(false)
+SCA_IInputDevice::SCA_IInputDevice() : m_eventTime(0.0), m_hookExitKey(false)
 {
   for (int i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
     m_inputsTable[i] = SCA_InputEvent(i);
@@ -141,6 +141,7 @@ void SCA_IInputDevice::ClearInputs()
     m_inputsTable[i].Clear();
   }
   m_text.clear();
+  m_events.clear();
 }
 
 void SCA_IInputDevice::ReleaseMoveEvent()
@@ -169,6 +170,21 @@ const std::wstring &SCA_IInputDevice::GetText() const
   return m_text;
 }
 
+void SCA_IInputDevice::AddEventRecord(SCA_EnumInputs type, int value)
+{
+  m_events.push_back({type, value, m_eventTime});
+}
+
+void SCA_IInputDevice::SetEventTime(double time)
+{
+  m_eventTime = time;
+}
+
+const std::vector<SCA_IInputDevice::EventRecord> &SCA_IInputDevice::GetEvents() const
+{
+  return m_events;
+}
+
 const char SCA_IInputDevice::ConvertKeyToChar(SCA_IInputDevice::SCA_EnumInputs input, bool shifted)
 {
   std::map<SCA_EnumInputs, std::pair<char, char>>::iterator it = m_keyToChar.find(input);
@@ -33,6 +33,7 @@
 
 
 #include <map>
+#include <vector>
 
 #include "SCA_InputEvent.h"
 
@@ -205,12 +206,25 @@ class SCA_IInputDevice {
     MAX_KEYS
   };  // enum
 
+  /// An input change, in the order received from the system.
+  struct EventRecord {
+    SCA_EnumInputs m_type;
+    int m_value;
+    /// Arrival time in seconds, see PIL_check_seconds_timer().
+    double m_time;
+  };
+
  protected:
   /// Table of all possible input.
   SCA_InputEvent m_inputsTable[SCA_IInputDevice::MAX_KEYS];
   /// Typed text in unicode during a frame.
   std::wstring m_text;
 
+  /// All the input changes during a frame, with their order between the different inputs.
+  std::vector<EventRecord> m_events;
+  /// Arrival time of the events being converted.
+  double m_eventTime;
+
   /// True when a sensor handle the same key as the exit key.
   bool m_hookExitKey;
 
@@ -219,6 +233,9 @@ class SCA_IInputDevice {
    */
   static std::map<SCA_EnumInputs, std::pair<char, char>> m_keyToChar;
 
+  /// Record an input change at the current event time.
+  void AddEventRecord(SCA_EnumInputs type, int value);
+
  public:
   virtual SCA_InputEvent &GetInput(SCA_IInputDevice::SCA_EnumInputs inputcode);
 
@@ -240,6 +257,11 @@ class SCA_IInputDevice {
   /// Return typed unicode text during a frame.
   const std::wstring &GetText() const;
 
+  /// Set the arrival time of the next converted events.
+  void SetEventTime(double time);
+  /// Return all the input changes during a frame, in arrival order.
+  const std::vector<EventRecord> &GetEvents() const;
+
   static const char ConvertKeyToChar(SCA_EnumInputs input, bool shifted);
 };
 
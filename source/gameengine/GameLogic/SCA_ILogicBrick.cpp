@@ -76,7 +76,10 @@ std::string SCA_ILogicBrick::GetName()
 
 void SCA_ILogicBrick::SetName(const std::string &name)
 {
-  m_name = name;
+  if (name != m_name) {
+    m_name = name;
+    NameChanged();
+  }
 }
 
 void SCA_ILogicBrick::SetLogicManager(SCA_LogicManager *logicmgr)
@@ -112,6 +112,34 @@ void SCA_IObject::UnregisterActuator(SCA_IActuator *act)
   }
 }
 
+void SCA_IObject::SetProperty(const std::string &name, CValue *ioProperty)
+{
+  CValue::SetProperty(name, ioProperty);
+  PropertiesChanged();
+}
+
+bool SCA_IObject::RemoveProperty(const std::string &inName)
+{
+  const bool removed = CValue::RemoveProperty(inName);
+  if (removed) {
+    PropertiesChanged();
+  }
+  return removed;
+}
+
+void SCA_IObject::ClearProperties()
+{
+  CValue::ClearProperties();
+  PropertiesChanged();
+}
+
+void SCA_IObject::PropertiesChanged()
+{
+  for (SCA_ISensor *sensor : m_sensors) {
+    sensor->PropertiesChanged();
+  }
+}
+
 void SCA_IObject::RegisterObject(SCA_IObject *obj)
 {
   // one object may be registered multiple times via constraint target
@@ -138,6 +138,14 @@ class SCA_IObject : public CValue {
 
   void RegisterObject(SCA_IObject *objs);
   void UnregisterObject(SCA_IObject *objs);
+
+  virtual void SetProperty(const std::string &name, CValue *ioProperty);
+  virtual bool RemoveProperty(const std::string &inName);
+  virtual void ClearProperties();
+  /** Notify the sensors that a property was added, removed or modified in place.
+   * Sleeping sensors watching a property rely on it to be evaluated again.
+   */
+  void PropertiesChanged();
   /**
    * UnlinkObject(...)
    * this object is informed that one of the object to which it holds a reference is deleted
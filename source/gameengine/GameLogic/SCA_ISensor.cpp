@@ -57,7 +57,8 @@ SCA_ISensor::SCA_ISensor(SCA_IObject *gameobj, SCA_EventManager *eventmgr)
       m_suspended(false),
       m_links(0),
       m_state(false),
-      m_prev_state(false)
+      m_prev_state(false),
+      m_sleeping(false)
 {
 }
 
@@ -69,6 +70,7 @@ void SCA_ISensor::ProcessReplica()
 {
   SCA_ILogicBrick::ProcessReplica();
   m_linkedcontrollers.clear();
+  m_sleeping = false;
 }
 
 bool SCA_ISensor::IsPositiveTrigger()
@@ -130,6 +132,45 @@ bool SCA_ISensor::IsSuspended()
 void SCA_ISensor::Resume()
 {
   m_suspended = false;
+  WakeUp();
+}
+
+bool SCA_ISensor::CanSleep()
+{
+  return false;
+}
+
+void SCA_ISensor::PropertiesChanged()
+{
+}
+
+bool SCA_ISensor::TrySleep()
+{
+  // Pulses, tap and level modes need an evaluation every frame.
+  if (m_pos_pulsemode || m_neg_pulsemode || m_tap || m_level || m_suspended || !CanSleep()) {
+    return false;
+  }
+
+  m_sleeping = true;
+  return true;
+}
+
+void SCA_ISensor::WakeUp()
+{
+  if (m_sleeping) {
+    m_sleeping = false;
+    m_eventmgr->WakeUpSensor(this);
+  }
+}
+
+bool SCA_ISensor::IsSleeping() const
+{
+  return m_sleeping;
+}
+
+void SCA_ISensor::ClearSleeping()
+{
+  m_sleeping = false;
 }
 
 bool SCA_ISensor::GetState()
@@ -341,6 +382,7 @@ KX_PYMETHODDEF_DOC_NOARGS(
 {
   Init();
   m_prev_state = false;
+  WakeUp();
   Py_RETURN_NONE;
 }
 
@@ -391,10 +433,12 @@ PyMethodDef SCA_ISensor::Methods[] = {
 };
 
 PyAttributeDef SCA_ISensor::Attributes[] = {
-    KX_PYATTRIBUTE_BOOL_RW("usePosPulseMode", SCA_ISensor, m_pos_pulsemode),
-    KX_PYATTRIBUTE_BOOL_RW("useNegPulseMode", SCA_ISensor, m_neg_pulsemode),
+    KX_PYATTRIBUTE_BOOL_RW_CHECK(
+        "usePosPulseMode", SCA_ISensor, m_pos_pulsemode, pyattr_check_wake_up),
+    KX_PYATTRIBUTE_BOOL_RW_CHECK(
+        "useNegPulseMode", SCA_ISensor, m_neg_pulsemode, pyattr_check_wake_up),
     KX_PYATTRIBUTE_INT_RW("skippedTicks", 0, 100000, true, SCA_ISensor, m_skipped_ticks),
-    KX_PYATTRIBUTE_BOOL_RW("invert", SCA_ISensor, m_invert),
+    KX_PYATTRIBUTE_BOOL_RW_CHECK("invert", SCA_ISensor, m_invert, pyattr_check_wake_up),
     KX_PYATTRIBUTE_BOOL_RW_CHECK("level", SCA_ISensor, m_level, pyattr_check_level),
     KX_PYATTRIBUTE_BOOL_RW_CHECK("tap", SCA_ISensor, m_tap, pyattr_check_tap),
     KX_PYATTRIBUTE_RO_FUNCTION("triggered", SCA_ISensor, pyattr_get_triggered),
@@ -460,6 +504,7 @@ int SCA_ISensor::pyattr_check_level(PyObjectPlus *self_v, const KX_PYATTRIBUTE_D
   if (self->m_level) {
     self->m_tap = false;
   }
+  self->WakeUp();
   return 0;
 }
 
@@ -469,6 +514,14 @@ int SCA_ISensor::pyattr_check_tap(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF
   if (self->m_tap) {
     self->m_level = false;
   }
+  self->WakeUp();
+  return 0;
+}
+
+int SCA_ISensor::pyattr_check_wake_up(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  SCA_ISensor *self = static_cast<SCA_ISensor *>(self_v);
+  self->WakeUp();
   return 0;
 }
 
@@ -88,6 +88,9 @@ class SCA_ISensor : public SCA_ILogicBrick {
   /// Previous state (for tap option).
   bool m_prev_state;
 
+  /// The event manager doesn't evaluate the sensor until it is woken up, see CanSleep.
+  bool m_sleeping;
+
   std::vector<SCA_IController *> m_linkedcontrollers;
 
  public:
@@ -113,6 +116,21 @@ class SCA_ISensor : public SCA_ILogicBrick {
   virtual bool IsPositiveTrigger();
   virtual void Init();
 
+  /** Return true if the evaluation of the sensor can't trigger anything until one of its wake up
+   * conditions happens, e.g a property change or a reset. Called after the sensor activation.
+   */
+  virtual bool CanSleep();
+  /// Called when a property of the parent object is set, modified or removed.
+  virtual void PropertiesChanged();
+
+  /// Put the sensor to sleep if possible, return true if the sensor is sleeping.
+  bool TrySleep();
+  /// Ask the event manager to evaluate the sensor again.
+  void WakeUp();
+  bool IsSleeping() const;
+  /// Mark the sensor awake without notifying the event manager, used by the event manager.
+  void ClearSleeping();
+
   virtual CValue *GetReplica() = 0;
 
   /** Set parameters for the pulsing behavior.
@@ -183,6 +201,8 @@ class SCA_ISensor : public SCA_ILogicBrick {
 
   static int pyattr_check_level(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
   static int pyattr_check_tap(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+  /// Wake up the sensor after a modification of its settings.
+  static int pyattr_check_wake_up(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
 
   enum SensorStatus {
     KX_SENSOR_INACTIVE = 0,
@@ -33,6 +33,7 @@
 #include "SCA_LogicManager.h"
 
 
+#include "KX_GameObject.h"
 #include "SCA_ISensor.h"
 #include "SCA_PythonController.h"
 
@@ -168,6 +169,10 @@ void SCA_LogicManager::UpdateFrame(double curtime)
       SCA_IActuator *actua = *ia;
       // increment first to allow removal of inactive actuators.
       ++ia;
+      // Only motion actuators can run with outdated world transforms.
+      if (actua->m_type != SCA_IActuator::KX_ACT_OBJECT) {
+        UpdateMovedObjects();
+      }
       if (!actua->Update(curtime)) {
         // this actuator is not active anymore, remove
         actua->QDelink();
@@ -189,6 +194,24 @@ void SCA_LogicManager::UpdateFrame(double curtime)
       ahead->Delink();
     }
   }
+
+  UpdateMovedObjects();
+}
+
+void SCA_LogicManager::AddMovedObject(KX_GameObject *gameobj)
+{
+  // Motion actuators of the same object are usually consecutive.
+  if (m_movedObjects.empty() || m_movedObjects.back() != gameobj) {
+    m_movedObjects.push_back(gameobj);
+  }
+}
+
+void SCA_LogicManager::UpdateMovedObjects()
+{
+  for (KX_GameObject *gameobj : m_movedObjects) {
+    gameobj->NodeUpdateGS(0.0f);
+  }
+  m_movedObjects.clear();
 }
 
 void *SCA_LogicManager::GetActionByName(const std::string &actname)
@@ -82,6 +82,9 @@ class SCA_LogicManager {
   std::map<std::string, void *> m_map_gamemeshname_to_blendobj;
   std::map<void *, CValue *> m_map_blendobj_to_gameobj;
 
+  /// Objects moved by motion actuators and waiting for their world transform update.
+  std::vector<class KX_GameObject *> m_movedObjects;
+
  public:
   SCA_LogicManager();
   virtual ~SCA_LogicManager();
@@ -102,6 +105,13 @@ class SCA_LogicManager {
   }
 
   void AddTriggeredController(SCA_IController *controller, SCA_ISensor *sensor);
+
+  /** Defer the world transform update of an object moved by an actuator, consecutive motion
+   * actuators then update the scene graph only once per object, see UpdateMovedObjects.
+   */
+  void AddMovedObject(class KX_GameObject *gameobj);
+  /// Update the world transform of all the objects moved since the last call.
+  void UpdateMovedObjects();
   SCA_EventManager *FindEventManager(int eventmgrtype);
   std::vector<class SCA_EventManager *> GetEventManagers()
   {
@@ -47,7 +47,11 @@ SCA_NearSensor::SCA_NearSensor(SCA_EventManager *eventmgr,
                                PHY_IPhysicsController *ctrl)
     : SCA_CollisionSensor(eventmgr, gameobj, bFindMaterial, false, touchedpropname),
       m_Margin(margin),
-      m_ResetMargin(resetmargin)
+      m_ResetMargin(resetmargin),
+      m_useSpatialHash(false),
+      m_registered(false),
+      m_registeredSpatialHash(false),
+      m_proximityRadius(margin)
 
 {
 
@@ -68,7 +72,7 @@ void SCA_NearSensor::SynchronizeTransform()
 {
   // The near and radar sensors are using a different physical object which is
   // not linked to the parent object, must synchronize it.
-  if (m_physCtrl) {
+  if (m_physCtrl && !m_registeredSpatialHash) {
     PHY_IMotionState *motionState = m_physCtrl->GetMotionState();
     KX_GameObject *parent = ((KX_GameObject *)GetParent());
     motionState->SetWorldPosition(parent->NodeGetWorldPosition());
@@ -90,6 +94,9 @@ void SCA_NearSensor::ProcessReplica()
 
   m_client_info = new KX_ClientObjectInfo(m_client_info->m_gameobject,
                                           KX_ClientObjectInfo::SENSOR);
+  // The replica is registered later by its own event manager.
+  m_registered = false;
+  m_registeredSpatialHash = false;
 
   if (m_physCtrl) {
     m_physCtrl = m_physCtrl->GetReplicaForSensors();
@@ -126,6 +133,8 @@ SCA_NearSensor::~SCA_NearSensor()
 
 void SCA_NearSensor::SetPhysCtrlRadius()
 {
+  m_proximityRadius = m_bTriggered ? m_ResetMargin : m_Margin;
+
   if (m_bTriggered) {
     if (m_physCtrl) {
       m_physCtrl->SetRadius(m_ResetMargin);
@@ -154,6 +163,77 @@ bool SCA_NearSensor::Evaluate()
   return result;
 }
 
+void SCA_NearSensor::RegisterSumo(KX_CollisionEventManager *collisionman)
+{
+  if (m_useSpatialHash) {
+    collisionman->AddProximitySensor(this);
+  }
+  else {
+    SCA_CollisionSensor::RegisterSumo(collisionman);
+  }
+
+  m_registered = true;
+  m_registeredSpatialHash = m_useSpatialHash;
+}
+
+void SCA_NearSensor::UnregisterSumo(KX_CollisionEventManager *collisionman)
+{
+  if (m_registeredSpatialHash) {
+    collisionman->RemoveProximitySensor(this);
+  }
+  else {
+    SCA_CollisionSensor::UnregisterSumo(collisionman);
+  }
+
+  m_registered = false;
+  m_registeredSpatialHash = false;
+}
+
+void SCA_NearSensor::UpdateDetectionMethod()
+{
+  if (m_registered && m_registeredSpatialHash != m_useSpatialHash) {
+    KX_CollisionEventManager *collisionman = static_cast<KX_CollisionEventManager *>(m_eventmgr);
+    UnregisterSumo(collisionman);
+    RegisterSumo(collisionman);
+    // The physics object was not synchronized meanwhile.
+    SynchronizeTransform();
+  }
+}
+
+void SCA_NearSensor::GetProximityBounds(MT_Vector3 &center, float &radius) const
+{
+  center = static_cast<KX_GameObject *>(m_gameobj)->NodeGetWorldPosition();
+  radius = m_proximityRadius;
+}
+
+bool SCA_NearSensor::TestProximity(const MT_Vector3 &position, float radius) const
+{
+  const MT_Vector3 &center = static_cast<KX_GameObject *>(m_gameobj)->NodeGetWorldPosition();
+  const float distance = m_proximityRadius + radius;
+  return (position - center).length2() <= distance * distance;
+}
+
+bool SCA_NearSensor::FilterProximity(KX_GameObject *gameobj) const
+{
+  // Same rules as BroadPhaseFilterCollision.
+  if (gameobj == m_gameobj || gameobj->getClientInfo()->m_type != KX_ClientObjectInfo::ACTOR) {
+    return false;
+  }
+
+  return (m_touchedpropname.empty() || gameobj->GetProperty(m_touchedpropname));
+}
+
+void SCA_NearSensor::HandleProximity(KX_GameObject *gameobj)
+{
+  if (m_links && !m_suspended) {
+    if (!m_colliders->SearchValue(gameobj)) {
+      m_colliders->Add(CM_AddRef(gameobj));
+    }
+    m_bTriggered = true;
+    m_hitObject = gameobj;
+  }
+}
+
 // this function is called at broad phase stage to check if the two controller
 // need to interact at all. It is used for Near/Radar sensor that don't need to
 // check collision with object not included in filter
@@ -273,6 +353,8 @@ PyAttributeDef SCA_NearSensor::Attributes[] = {
         "distance", 0, 10000, SCA_NearSensor, m_Margin, CheckResetDistance),
     KX_PYATTRIBUTE_FLOAT_RW_CHECK(
         "resetDistance", 0, 10000, SCA_NearSensor, m_ResetMargin, CheckResetDistance),
+    KX_PYATTRIBUTE_BOOL_RW_CHECK(
+        "useSpatialHash", SCA_NearSensor, m_useSpatialHash, CheckUseSpatialHash),
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
@@ -34,6 +34,7 @@
 
 
 #include "KX_ClientObjectInfo.h"
+#include "MT_Vector3.h"
 #include "SCA_CollisionSensor.h"
 
 class KX_Scene;
@@ -45,6 +46,14 @@ class SCA_NearSensor : public SCA_CollisionSensor {
 
   KX_ClientObjectInfo *m_client_info;
 
+  /// Answer the sensor by the proximity grid of the event manager instead of a physics object.
+  bool m_useSpatialHash;
+  /// The sensor is registered to the event manager, and with which method.
+  bool m_registered;
+  bool m_registeredSpatialHash;
+  /// Current detection distance, the distance or the reset distance.
+  float m_proximityRadius;
+
  public:
   SCA_NearSensor(class SCA_EventManager *eventmgr,
                  class KX_GameObject *gameobj,
@@ -71,6 +80,20 @@ public:
   virtual bool Evaluate();
 
   virtual void ReParent(SCA_IObject *parent);
+  virtual void RegisterSumo(KX_CollisionEventManager *collisionman);
+  virtual void UnregisterSumo(KX_CollisionEventManager *collisionman);
+  /// Register again the sensor if the detection method changed.
+  void UpdateDetectionMethod();
+
+  /// Sphere enclosing the detection volume used to query the proximity grid.
+  virtual void GetProximityBounds(MT_Vector3 &center, float &radius) const;
+  /// Return true if the sphere intersects the detection volume, must be thread safe.
+  virtual bool TestProximity(const MT_Vector3 &position, float radius) const;
+  /// Return true if the object can be detected, must be thread safe.
+  bool FilterProximity(KX_GameObject *gameobj) const;
+  /// Record an object detected by the proximity grid.
+  void HandleProximity(KX_GameObject *gameobj);
+
   virtual bool NewHandleCollision(void *obj1, void *obj2, const PHY_CollData *coll_data);
   virtual bool BroadPhaseFilterCollision(void *obj1, void *obj2);
   virtual bool BroadPhaseSensorFilterCollision(void *obj1, void *obj2)
@@ -103,6 +126,13 @@ public:
     return 0;
   }
 
+  static int CheckUseSpatialHash(PyObjectPlus *self, const PyAttributeDef *)
+  {
+    SCA_NearSensor *sensor = reinterpret_cast<SCA_NearSensor *>(self);
+    sensor->UpdateDetectionMethod();
+    return 0;
+  }
+
 #endif /* WITH_PYTHON */
 };
 
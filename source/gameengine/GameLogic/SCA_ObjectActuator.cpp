@@ -110,8 +110,11 @@ bool SCA_ObjectActuator::Update()
   RemoveAllEvents();
 
   KX_GameObject *parent = static_cast<KX_GameObject *>(GetParent());
-  PHY_ICharacter *character = parent->GetScene()->GetPhysicsEnvironment()->GetCharacterController(
-      parent);
+  // Only look up the character controller when it is used.
+  PHY_ICharacter *character = nullptr;
+  if (m_bitLocalFlag.CharacterMotion) {
+    character = parent->GetScene()->GetPhysicsEnvironment()->GetCharacterController(parent);
+  }
 
   if (bNegativeEvent) {
     // Explicitly stop the movement if we're using character motion
@@ -144,6 +147,8 @@ bool SCA_ObjectActuator::Update()
         return false;
       MT_Vector3 v = parent->GetLinearVelocity(m_bitLocalFlag.LinearVelocity);
       if (m_reference) {
+        // The world positions must be up to date.
+        m_logicManager->UpdateMovedObjects();
         const MT_Vector3 &mypos = parent->NodeGetWorldPosition();
         const MT_Vector3 &refpos = m_reference->NodeGetWorldPosition();
         MT_Vector3 relpos;
@@ -240,11 +245,28 @@ bool SCA_ObjectActuator::Update()
       if (!m_bitLocalFlag.ZeroTorque) {
         parent->ApplyTorque(m_torque, (m_bitLocalFlag.Torque) != 0);
       }
-      if (!m_bitLocalFlag.ZeroDLoc) {
-        parent->ApplyMovement(m_dloc, (m_bitLocalFlag.DLoc) != 0);
-      }
-      if (!m_bitLocalFlag.ZeroDRot) {
-        parent->ApplyRotation(m_drot, (m_bitLocalFlag.DRot) != 0);
+      if (!m_bitLocalFlag.ZeroDLoc || !m_bitLocalFlag.ZeroDRot) {
+        /* A global motion of a child object uses the world transform of its parent, the pending
+         * updates are done before. Else the world transform update is shared with the next
+         * motion actuators. */
+        const bool deferUpdate = (parent->GetParent() == nullptr);
+        if (!deferUpdate) {
+          m_logicManager->UpdateMovedObjects();
+        }
+
+        if (!m_bitLocalFlag.ZeroDLoc) {
+          parent->ApplyMovement(m_dloc, (m_bitLocalFlag.DLoc) != 0, false);
+        }
+        if (!m_bitLocalFlag.ZeroDRot) {
+          parent->ApplyRotation(m_drot, (m_bitLocalFlag.DRot) != 0, false);
+        }
+
+        if (deferUpdate) {
+          m_logicManager->AddMovedObject(parent);
+        }
+        else {
+          parent->NodeUpdateGS(0.0f);
+        }
       }
       if (!m_bitLocalFlag.ZeroLinearVelocity) {
         if (m_bitLocalFlag.AddOrSetLinV) {
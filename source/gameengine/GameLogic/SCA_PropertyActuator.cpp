@@ -72,7 +72,7 @@ bool SCA_PropertyActuator::Update()
 
   bool bNegativeEvent = IsNegativeEvent();
   RemoveAllEvents();
-  CValue *propowner = GetParent();
+  SCA_IObject *propowner = GetParent();
 
   if (bNegativeEvent) {
     if (m_type == KX_ACT_PROP_LEVEL) {
@@ -80,6 +80,7 @@ bool SCA_PropertyActuator::Update()
       CValue *oldprop = propowner->GetProperty(m_propname);
       if (oldprop) {
         oldprop->SetValue(newval);
+        propowner->PropertiesChanged();
       }
       newval->Release();
     }
@@ -98,6 +99,7 @@ bool SCA_PropertyActuator::Update()
     if (oldprop) {
       newval = new CBoolValue((oldprop->GetNumber() == 0.0) ? true : false);
       oldprop->SetValue(newval);
+      propowner->PropertiesChanged();
     }
     else { /* as not been assigned, evaluate as false, so assign true */
       newval = new CBoolValue(true);
@@ -110,6 +112,7 @@ bool SCA_PropertyActuator::Update()
     CValue *oldprop = propowner->GetProperty(m_propname);
     if (oldprop) {
       oldprop->SetValue(newval);
+      propowner->PropertiesChanged();
     }
     else {
       propowner->SetProperty(m_propname, newval);
@@ -125,6 +128,7 @@ bool SCA_PropertyActuator::Update()
         CValue *oldprop = propowner->GetProperty(m_propname);
         if (oldprop) {
           oldprop->SetValue(newval);
+          propowner->PropertiesChanged();
         }
         else {
           propowner->SetProperty(m_propname, newval);
@@ -141,6 +145,7 @@ bool SCA_PropertyActuator::Update()
 
           CValue *newprop = expr->Calculate();
           oldprop->SetValue(newprop);
+          propowner->PropertiesChanged();
           newprop->Release();
           expr->Release();
         }
@@ -108,6 +108,23 @@ bool SCA_PropertySensor::Evaluate()
   return (reset) ? true : false;
 }
 
+bool SCA_PropertySensor::CanSleep()
+{
+  // A changed property is reported during one frame only.
+  if (m_checktype == KX_PROPSENSOR_CHANGED && m_recentresult) {
+    return false;
+  }
+
+  // Timer properties are modified every frame without notification.
+  CValue *prop = GetParent()->GetProperty(m_checkpropname);
+  return !(prop && prop->GetProperty("timer"));
+}
+
+void SCA_PropertySensor::PropertiesChanged()
+{
+  WakeUp();
+}
+
 bool SCA_PropertySensor::CheckPropertyCondition()
 {
   m_recentresult = false;
@@ -242,9 +259,16 @@ int SCA_PropertySensor::validValueForProperty(PyObjectPlus *self, const PyAttrib
    * function directly */
 
   /*  There is no type checking at this moment, unfortunately...           */
+  reinterpret_cast<SCA_PropertySensor *>(self)->WakeUp();
   return 0;
 }
 
+int SCA_PropertySensor::CheckPropertyName(PyObjectPlus *self, const PyAttributeDef *attrdef)
+{
+  reinterpret_cast<SCA_PropertySensor *>(self)->WakeUp();
+  return CheckProperty(self, attrdef);
+}
+
 /* Integration hooks ------------------------------------------------------- */
 PyTypeObject SCA_PropertySensor::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "SCA_PropertySensor",
                                          sizeof(PyObjectPlus_Proxy),
@@ -289,14 +313,20 @@ PyMethodDef SCA_PropertySensor::Methods[] = {
 };
 
 PyAttributeDef SCA_PropertySensor::Attributes[] = {
-    KX_PYATTRIBUTE_INT_RW("mode",
-                          KX_PROPSENSOR_NODEF,
-                          KX_PROPSENSOR_MAX - 1,
-                          false,
-                          SCA_PropertySensor,
-                          m_checktype),
-    KX_PYATTRIBUTE_STRING_RW_CHECK(
-        "propName", 0, MAX_PROP_NAME, false, SCA_PropertySensor, m_checkpropname, CheckProperty),
+    KX_PYATTRIBUTE_INT_RW_CHECK("mode",
+                                KX_PROPSENSOR_NODEF,
+                                KX_PROPSENSOR_MAX - 1,
+                                false,
+                                SCA_PropertySensor,
+                                m_checktype,
+                                pyattr_check_wake_up),
+    KX_PYATTRIBUTE_STRING_RW_CHECK("propName",
+                                   0,
+                                   MAX_PROP_NAME,
+                                   false,
+                                   SCA_PropertySensor,
+                                   m_checkpropname,
+                                   CheckPropertyName),
     KX_PYATTRIBUTE_STRING_RW_CHECK(
         "value", 0, 100, false, SCA_PropertySensor, m_checkpropval, validValueForProperty),
     KX_PYATTRIBUTE_STRING_RW_CHECK(
@@ -76,6 +76,8 @@ class SCA_PropertySensor : public SCA_ISensor {
 
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
+  virtual bool CanSleep();
+  virtual void PropertiesChanged();
   virtual CValue *FindIdentifier(const std::string &identifiername);
 
 #ifdef WITH_PYTHON
@@ -88,6 +90,7 @@ class SCA_PropertySensor : public SCA_ISensor {
    * Test whether this is a sensible value (type check)
    */
   static int validValueForProperty(PyObjectPlus *self, const PyAttributeDef *);
+  static int CheckPropertyName(PyObjectPlus *self, const PyAttributeDef *attrdef);
 
 #endif
 };
@@ -54,7 +54,9 @@ SCA_PythonController::SCA_PythonController(SCA_IObject *gameobj, int mode)
       m_function_argc(0),
       m_bModified(true),
       m_debug(false),
-      m_mode(mode)
+      m_mode(mode),
+      m_scriptText(std::make_shared<const std::string>()),
+      m_scriptName(std::make_shared<const std::string>())
 #ifdef WITH_PYTHON
       ,
       m_pythondictionary(nullptr)
@@ -111,13 +113,14 @@ CValue *SCA_PythonController::GetReplica()
 
 void SCA_PythonController::SetScriptText(const std::string &text)
 {
-  m_scriptText = text;
+  // Replace instead of modify, the previous text can be used by other replicas.
+  m_scriptText = std::make_shared<const std::string>(text);
   m_bModified = true;
 }
 
 void SCA_PythonController::SetScriptName(const std::string &name)
 {
-  m_scriptName = name;
+  m_scriptName = std::make_shared<const std::string>(name);
 }
 
 bool SCA_PythonController::IsTriggered(class SCA_ISensor *sensor)
@@ -258,7 +261,7 @@ bool SCA_PythonController::Compile()
   }
 
   // recompile the scripttext into bytecode
-  m_bytecode = Py_CompileString(m_scriptText.c_str(), m_scriptName.c_str(), Py_file_input);
+  m_bytecode = Py_CompileString(m_scriptText->c_str(), m_scriptName->c_str(), Py_file_input);
 
   if (m_bytecode) {
     return true;
@@ -277,7 +280,7 @@ bool SCA_PythonController::Import()
   Py_XDECREF(m_function);
   m_function = nullptr;
 
-  std::string mod_path = m_scriptText; /* just for storage, use C style string access */
+  std::string mod_path = *m_scriptText; /* just for storage, use C style string access */
   std::string function_string;
 
   const int pos = mod_path.rfind('.');
@@ -289,7 +292,7 @@ bool SCA_PythonController::Import()
   if (function_string.empty()) {
     CM_LogicBrickError(this,
                        "python module name formatting expected 'SomeModule.Func', got '"
-                           << m_scriptText << "'");
+                           << *m_scriptText << "'");
     return false;
   }
 
@@ -320,14 +323,14 @@ bool SCA_PythonController::Import()
       ErrorPrint("python controller found the module but could not access the function");
     else
       CM_LogicBrickError(this,
-                         "python module '" << m_scriptText << "' found but function missing");
+                         "python module '" << *m_scriptText << "' found but function missing");
     return false;
   }
 
   if (!PyCallable_Check(m_function)) {
     Py_DECREF(m_function);
     m_function = nullptr;
-    CM_LogicBrickError(this, "python module function '" << m_scriptText << "' not callable");
+    CM_LogicBrickError(this, "python module function '" << *m_scriptText << "' not callable");
     return false;
   }
 
@@ -342,7 +345,7 @@ bool SCA_PythonController::Import()
     m_function = nullptr;
     CM_LogicBrickError(this,
                        "python module function:\n '"
-                           << m_scriptText << "' takes " << m_function_argc
+                           << *m_scriptText << "' takes " << m_function_argc
                            << " args, should be zero or 1 controller arg");
     return false;
   }
@@ -388,7 +391,7 @@ void SCA_PythonController::Trigger(SCA_LogicManager *logicmgr)
 
         /* Without __file__ set the sys.argv[0] is used for the filename
          * which ends up with lines from the blender binary being printed in the console */
-        PyObject *value = PyUnicode_FromStdString(m_scriptName);
+        PyObject *value = PyUnicode_FromStdString(*m_scriptName);
         PyDict_SetItemString(m_pythondictionary, "__file__", value);
         Py_DECREF(value);
       }
@@ -479,7 +482,7 @@ PyObject *SCA_PythonController::pyattr_get_script(PyObjectPlus *self_v,
   // static_cast<void *>(dynamic_cast<Derived *>(obj)) - static_cast<void *>(obj)
 
   SCA_PythonController *self = static_cast<SCA_PythonController *>(self_v);
-  return PyUnicode_FromStdString(self->m_scriptText);
+  return PyUnicode_FromStdString(*self->m_scriptText);
 }
 
 int SCA_PythonController::pyattr_set_script(PyObjectPlus *self_v,
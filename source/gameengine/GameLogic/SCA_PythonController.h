@@ -33,6 +33,7 @@
 #pragma once
 
 
+#include <memory>
 #include <vector>
 
 #include "EXP_BoolValue.h"
@@ -52,8 +53,9 @@ class SCA_PythonController : public SCA_IController {
   int m_mode;
 
  protected:
-  std::string m_scriptText;
-  std::string m_scriptName;
+  /// Script text or module name and script name, immutable and shared between the replicas.
+  std::shared_ptr<const std::string> m_scriptText;
+  std::shared_ptr<const std::string> m_scriptName;
 #ifdef WITH_PYTHON
   PyObject *m_pythondictionary; /* for SCA_PYEXEC_SCRIPT only */
   PyObject *m_pythonfunction;   /* for SCA_PYEXEC_MODULE only */
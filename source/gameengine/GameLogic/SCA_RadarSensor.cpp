@@ -155,7 +155,7 @@ void SCA_RadarSensor::SynchronizeTransform()
   m_cone_target[1] = temp[1];
   m_cone_target[2] = temp[2];
 
-  if (m_physCtrl) {
+  if (m_physCtrl && !m_registeredSpatialHash) {
     PHY_IMotionState *motionState = m_physCtrl->GetMotionState();
     motionState->SetWorldPosition(trans.getOrigin());
     motionState->SetWorldOrientation(trans.getBasis());
@@ -163,6 +163,38 @@ void SCA_RadarSensor::SynchronizeTransform()
   }
 }
 
+void SCA_RadarSensor::GetProximityBounds(MT_Vector3 &center, float &radius) const
+{
+  // The cone origin is the middle of the cone axis.
+  center = MT_Vector3(m_cone_origin);
+  radius = sqrtf(m_coneheight * m_coneheight * 0.25f + m_coneradius * m_coneradius);
+}
+
+bool SCA_RadarSensor::TestProximity(const MT_Vector3 &position, float radius) const
+{
+  if (m_coneheight <= 0.0f) {
+    return false;
+  }
+
+  // The apex of the cone is the object position and the target the center of the base.
+  const MT_Vector3 apex = static_cast<KX_GameObject *>(m_gameobj)->NodeGetWorldPosition();
+  const MT_Vector3 axis = (MT_Vector3(m_cone_target) - apex) / m_coneheight;
+  const MT_Vector3 delta = position - apex;
+
+  const float dist = delta.dot(axis);
+  if (dist < -radius || dist > m_coneheight + radius) {
+    return false;
+  }
+
+  // Signed distance from the sphere center to the cone side.
+  const float side = sqrtf(m_coneheight * m_coneheight + m_coneradius * m_coneradius);
+  const float cosAngle = m_coneheight / side;
+  const float sinAngle = m_coneradius / side;
+  const float ortho = (delta - axis * dist).length();
+
+  return (ortho * cosAngle - dist * sinAngle) <= radius;
+}
+
 /* ------------------------------------------------------------------------- */
 /* Python Functions															 */
 /* ------------------------------------------------------------------------- */
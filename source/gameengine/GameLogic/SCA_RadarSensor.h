@@ -76,6 +76,9 @@ class SCA_RadarSensor : public SCA_NearSensor {
   virtual void SynchronizeTransform();
   virtual CValue *GetReplica();
 
+  virtual void GetProximityBounds(MT_Vector3 &center, float &radius) const;
+  virtual bool TestProximity(const MT_Vector3 &position, float radius) const;
+
   /* --------------------------------------------------------------------- */
   /* Python interface ---------------------------------------------------- */
   /* --------------------------------------------------------------------- */
@@ -223,9 +223,11 @@ bool SCA_RandomActuator::Update()
   }
 
   /* Round up: assign it */
-  CValue *prop = GetParent()->GetProperty(m_propname);
+  SCA_IObject *parent = GetParent();
+  CValue *prop = parent->GetProperty(m_propname);
   if (prop) {
     prop->SetValue(tmpval);
+    parent->PropertiesChanged();
   }
   tmpval->Release();
 
@@ -35,6 +35,8 @@
 
 #include "SCA_SoundActuator.h"
 
+#include <algorithm>
+
 #ifdef WITH_AUDASPACE
 typedef float sample_t;
 #  include <AUD_Device.h>
@@ -47,6 +49,8 @@ typedef float sample_t;
 
 #include "KX_Camera.h"
 #include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+#include "KX_SoundManager.h"
 
 /* ------------------------------------------------------------------------- */
 /* Native functions                                                          */
@@ -72,6 +76,7 @@ SCA_SoundActuator::SCA_SoundActuator(SCA_IObject *gameobj,
   m_3d = settings;
   m_type = type;
   m_isplaying = false;
+  m_culled = false;
 }
 
 SCA_SoundActuator::~SCA_SoundActuator()
@@ -81,6 +86,12 @@ SCA_SoundActuator::~SCA_SoundActuator()
     AUD_Handle_stop(m_handle);
   }
 
+  // Don't let the sound manager update a deleted actuator.
+  KX_KetsjiEngine *engine = KX_GetActiveEngine();
+  if (engine) {
+    engine->GetSoundManager()->RemoveSource(this);
+  }
+
   if (m_sound) {
     AUD_Sound_free(m_sound);
   }
@@ -94,6 +105,7 @@ void SCA_SoundActuator::play()
     AUD_Handle_stop(m_handle);
     m_handle = nullptr;
   }
+  m_culled = false;
 
   if (!m_sound)
     return;
@@ -149,6 +161,54 @@ void SCA_SoundActuator::play()
 #endif  // WITH_AUDASPACE
 }
 
+bool SCA_SoundActuator::playing() const
+{
+#ifdef WITH_AUDASPACE
+  if (!m_handle) {
+    return false;
+  }
+
+  const AUD_Status status = AUD_Handle_getStatus(m_handle);
+  return (status == AUD_STATUS_PLAYING) || (m_culled && status == AUD_STATUS_PAUSED);
+#else
+  return false;
+#endif  // WITH_AUDASPACE
+}
+
+void SCA_SoundActuator::update3d()
+{
+#ifdef WITH_AUDASPACE
+  KX_Camera *cam = KX_GetActiveScene()->GetActiveCamera();
+  if (!cam) {
+    return;
+  }
+
+  KX_GameObject *obj = (KX_GameObject *)this->GetParent();
+  const MT_Matrix3x3 Mo = cam->NodeGetWorldOrientation().inverse();
+  float location[3];
+  float velocity[3];
+  float orientation[4];
+
+  const MT_Vector3 p = Mo * (obj->NodeGetWorldPosition() - cam->NodeGetWorldPosition());
+  p.getValue(location);
+  (Mo * (obj->GetLinearVelocity() - cam->GetLinearVelocity())).getValue(velocity);
+  (Mo * obj->NodeGetWorldOrientation()).getRotation().getValue(orientation);
+
+  /* Estimate the gain at the listener with the default inverse clamped distance model, the
+   * sound manager keeps the most audible sources when the voices are limited. */
+  const float distance = std::min((float)p.length(), m_3d.max_distance);
+  float gain = 1.0f;
+  if (distance > m_3d.reference_distance && m_3d.reference_distance > 0.0f) {
+    gain = m_3d.reference_distance /
+           (m_3d.reference_distance +
+            m_3d.rolloff_factor * (distance - m_3d.reference_distance));
+  }
+  gain = std::min(std::max(gain, m_3d.min_gain), m_3d.max_gain) * m_volume;
+
+  KX_GetActiveEngine()->GetSoundManager()->AddSource(this, location, velocity, orientation, gain);
+#endif  // WITH_AUDASPACE
+}
+
 CValue *SCA_SoundActuator::GetReplica()
 {
   SCA_SoundActuator *replica = new SCA_SoundActuator(*this);
@@ -163,6 +223,24 @@ void SCA_SoundActuator::ProcessReplica()
   m_handle = nullptr;
   m_sound = m_sound ? AUD_Sound_copy(m_sound) : nullptr;
 #endif  // WITH_AUDASPACE
+  m_culled = false;
+}
+
+#ifdef WITH_AUDASPACE
+AUD_Handle *SCA_SoundActuator::GetHandle() const
+{
+  return m_handle;
+}
+#endif  // WITH_AUDASPACE
+
+bool SCA_SoundActuator::GetCulled() const
+{
+  return m_culled;
+}
+
+void SCA_SoundActuator::SetCulled(bool culled)
+{
+  m_culled = culled;
 }
 
 bool SCA_SoundActuator::Update(double curtime)
@@ -182,7 +260,7 @@ bool SCA_SoundActuator::Update(double curtime)
     return false;
 
   // actual audio device playing state
-  bool isplaying = m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING) : false;
+  bool isplaying = playing();
 
   if (bNegativeEvent) {
     // here must be a check if it is still playing
@@ -233,29 +311,11 @@ bool SCA_SoundActuator::Update(double curtime)
       play();
   }
   // verify that the sound is still playing
-  isplaying = m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING) : false;
+  isplaying = playing();
 
   if (isplaying) {
     if (m_is3d) {
-      KX_Camera *cam = KX_GetActiveScene()->GetActiveCamera();
-      if (cam) {
-        KX_GameObject *obj = (KX_GameObject *)this->GetParent();
-        MT_Vector3 p;
-        MT_Matrix3x3 Mo;
-        float data[4];
-
-        Mo = cam->NodeGetWorldOrientation().inverse();
-        p = (obj->NodeGetWorldPosition() - cam->NodeGetWorldPosition());
-        p = Mo * p;
-        p.getValue(data);
-        AUD_Handle_setLocation(m_handle, data);
-        p = (obj->GetLinearVelocity() - cam->GetLinearVelocity());
-        p = Mo * p;
-        p.getValue(data);
-        AUD_Handle_setVelocity(m_handle, data);
-        (Mo * obj->NodeGetWorldOrientation()).getRotation().getValue(data);
-        AUD_Handle_setOrientation(m_handle, data);
-      }
+      update3d();
     }
     result = true;
   }
@@ -365,6 +425,7 @@ KX_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator,
       break;
     case AUD_STATUS_PAUSED:
       AUD_Handle_resume(m_handle);
+      m_culled = false;
       break;
     default:
       play();
@@ -382,6 +443,8 @@ KX_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator,
 #  ifdef WITH_AUDASPACE
   if (m_handle)
     AUD_Handle_pause(m_handle);
+  // A paused sound is not resumed by the voice limit.
+  m_culled = false;
 #  endif  // WITH_AUDASPACE
 
   Py_RETURN_NONE;
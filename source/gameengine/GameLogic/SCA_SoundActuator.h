@@ -62,8 +62,14 @@ class SCA_SoundActuator : public SCA_IActuator {
   float m_pitch;
   bool m_is3d;
   KX_3DSoundSettings m_3d;
+  /// The sound is paused by the voice limit of the sound manager.
+  bool m_culled;
 
   void play();
+  /// Return true if the sound is playing or only paused by the voice limit.
+  bool playing() const;
+  /// Submit the camera relative parameters of a 3D sound to the sound manager.
+  void update3d();
 
  public:
   enum KX_SOUNDACT_TYPE {
@@ -96,6 +102,12 @@ class SCA_SoundActuator : public SCA_IActuator {
   CValue *GetReplica();
   void ProcessReplica();
 
+#ifdef WITH_AUDASPACE
+  AUD_Handle *GetHandle() const;
+#endif  // WITH_AUDASPACE
+  bool GetCulled() const;
+  void SetCulled(bool culled);
+
 #ifdef WITH_PYTHON
 
   /* -------------------------------------------------------------------- */
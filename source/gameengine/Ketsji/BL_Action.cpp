@@ -255,6 +255,46 @@ const std::string BL_Action::GetName()
   }
 }
 
+float BL_Action::GetStartFrame()
+{
+  return m_startframe;
+}
+
+float BL_Action::GetEndFrame()
+{
+  return m_endframe;
+}
+
+float BL_Action::GetLayerWeight()
+{
+  return m_layer_weight;
+}
+
+float BL_Action::GetSpeed()
+{
+  return m_speed;
+}
+
+short BL_Action::GetPriority()
+{
+  return m_priority;
+}
+
+short BL_Action::GetPlayMode()
+{
+  return m_playmode;
+}
+
+short BL_Action::GetBlendMode()
+{
+  return m_blendmode;
+}
+
+short BL_Action::GetIpoFlags()
+{
+  return m_ipo_flags;
+}
+
 void BL_Action::SetFrame(float frame)
 {
   // Clamp the frame to the start and end frame
@@ -124,6 +124,14 @@ class BL_Action {
   const std::string GetName();
 
   struct bAction *GetAction();
+  float GetStartFrame();
+  float GetEndFrame();
+  float GetLayerWeight();
+  float GetSpeed();
+  short GetPriority();
+  short GetPlayMode();
+  short GetBlendMode();
+  short GetIpoFlags();
 
   // Mutators
   void SetFrame(float frame);
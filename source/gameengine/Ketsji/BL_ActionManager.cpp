@@ -52,6 +52,16 @@ BL_Action *BL_ActionManager::GetAction(short layer)
   return (it != m_layers.end()) ? it->second : 0;
 }
 
+std::vector<short> BL_ActionManager::GetActionLayers()
+{
+  std::vector<short> layers;
+  layers.reserve(m_layers.size());
+  for (const BL_ActionMap::value_type &pair : m_layers) {
+    layers.push_back(pair.first);
+  }
+  return layers;
+}
+
 float BL_ActionManager::GetActionFrame(short layer)
 {
   BL_Action *action = GetAction(layer);
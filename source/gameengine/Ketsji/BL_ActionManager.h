@@ -29,6 +29,7 @@
 
 #include <iostream>
 #include <map>
+#include <vector>
 
 // Currently, we use the max value of a short.
 // We should switch to unsigned short; doesn't make sense to support negative layers.
@@ -47,14 +48,19 @@ class BL_ActionManager {
   class KX_GameObject *m_obj;
   BL_ActionMap m_layers;
 
+ public:
+  BL_ActionManager(class KX_GameObject *obj);
+  ~BL_ActionManager();
+
   /**
    * Check if an action exists
    */
   BL_Action *GetAction(short layer);
 
- public:
-  BL_ActionManager(class KX_GameObject *obj);
-  ~BL_ActionManager();
+  /**
+   * Gets the layers with an action
+   */
+  std::vector<short> GetActionLayers();
 
   bool PlayAction(const std::string &name,
                   float start,
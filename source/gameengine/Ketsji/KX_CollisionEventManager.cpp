@@ -31,9 +31,15 @@
 
 #include "KX_CollisionEventManager.h"
 
+#include <algorithm>
+
+#include "BLI_task.h"
+
 #include "KX_CollisionContactPoints.h"
+#include "KX_Scene.h"
 #include "PHY_IPhysicsController.h"
 #include "PHY_IPhysicsEnvironment.h"
+#include "SCA_NearSensor.h"
 
 KX_CollisionEventManager::KX_CollisionEventManager(class SCA_LogicManager *logicmgr,
                                                    PHY_IPhysicsEnvironment *physEnv)
@@ -176,6 +182,104 @@ bool KX_CollisionEventManager::RemoveSensor(SCA_ISensor *sensor)
   return false;
 }
 
+void KX_CollisionEventManager::AddProximitySensor(SCA_NearSensor *sensor)
+{
+  m_proximitySensors.push_back(sensor);
+}
+
+void KX_CollisionEventManager::RemoveProximitySensor(SCA_NearSensor *sensor)
+{
+  m_proximitySensors.erase(
+      std::remove(m_proximitySensors.begin(), m_proximitySensors.end(), sensor),
+      m_proximitySensors.end());
+}
+
+struct ProximityTaskData {
+  const std::vector<SCA_NearSensor *> *sensors;
+  const KX_ProximityGrid *grid;
+  std::vector<std::vector<KX_GameObject *>> *hits;
+};
+
+static void proximity_sensor_task(void *__restrict userdata,
+                                  const int iter,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ProximityTaskData *data = static_cast<ProximityTaskData *>(userdata);
+  const SCA_NearSensor *sensor = (*data->sensors)[iter];
+  std::vector<KX_GameObject *> &hits = (*data->hits)[iter];
+
+  MT_Vector3 center;
+  float radius;
+  sensor->GetProximityBounds(center, radius);
+
+  std::vector<const KX_ProximityGrid::Entry *> entries;
+  data->grid->Query(center, radius, entries);
+
+  for (const KX_ProximityGrid::Entry *entry : entries) {
+    if (sensor->FilterProximity(entry->m_object) &&
+        sensor->TestProximity(entry->m_position, entry->m_radius)) {
+      hits.push_back(entry->m_object);
+    }
+  }
+}
+
+void KX_CollisionEventManager::UpdateProximitySensors()
+{
+  std::vector<SCA_NearSensor *> sensors;
+  float cellSize = 1.0f;
+  for (SCA_NearSensor *sensor : m_proximitySensors) {
+    if (sensor->IsNoLink() || sensor->IsSuspended()) {
+      continue;
+    }
+
+    MT_Vector3 center;
+    float radius;
+    sensor->GetProximityBounds(center, radius);
+    cellSize = std::max(cellSize, radius);
+
+    sensors.push_back(sensor);
+  }
+
+  if (sensors.empty()) {
+    return;
+  }
+
+  // All the sensors of the manager are in the same scene.
+  KX_Scene *scene = static_cast<KX_GameObject *>(sensors.front()->GetParent())->GetScene();
+
+  // Objects are approximated by a sphere of their physics radius.
+  std::vector<KX_ProximityGrid::Entry> entries;
+  for (KX_GameObject *gameobj : scene->GetObjectList()) {
+    PHY_IPhysicsController *ctrl = gameobj->GetPhysicsController();
+    if (!ctrl || gameobj->getClientInfo()->m_type != KX_ClientObjectInfo::ACTOR) {
+      continue;
+    }
+
+    const MT_Vector3 scale = gameobj->NodeGetWorldScaling().absolute();
+    const float radius = ctrl->GetRadius() * std::max(scale.x(), std::max(scale.y(), scale.z()));
+    entries.push_back({gameobj, gameobj->NodeGetWorldPosition(), radius});
+  }
+
+  m_proximityGrid.Build(entries, cellSize);
+
+  std::vector<std::vector<KX_GameObject *>> hits(sensors.size());
+  ProximityTaskData data = {&sensors, &m_proximityGrid, &hits};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (sensors.size() > 8);
+  BLI_task_parallel_range(0, sensors.size(), &data, proximity_sensor_task, &settings);
+
+  // Modifying the colliders list is not thread safe.
+  for (unsigned int i = 0, size = sensors.size(); i < size; ++i) {
+    for (KX_GameObject *gameobj : hits[i]) {
+      sensors[i]->HandleProximity(gameobj);
+    }
+  }
+
+  m_proximityGrid.Clear();
+}
+
 void KX_CollisionEventManager::EndFrame()
 {
   for (SCA_ISensor *sensor : m_sensors) {
@@ -189,6 +293,8 @@ void KX_CollisionEventManager::NextFrame()
     static_cast<SCA_CollisionSensor *>(sensor)->SynchronizeTransform();
   }
 
+  UpdateProximitySensors();
+
   for (const NewCollision& collision : m_newCollisions) {
     // Controllers
     PHY_IPhysicsController *ctrl1 = collision.first;
@@ -36,10 +36,12 @@
 #include <vector>
 
 #include "KX_GameObject.h"
+#include "KX_ProximityGrid.h"
 #include "SCA_CollisionSensor.h"
 #include "SCA_EventManager.h"
 
 class SCA_ISensor;
+class SCA_NearSensor;
 class PHY_IPhysicsEnvironment;
 
 class KX_CollisionEventManager : public SCA_EventManager {
@@ -70,6 +72,10 @@ class KX_CollisionEventManager : public SCA_EventManager {
 
   std::set<NewCollision> m_newCollisions;
 
+  /// Near and radar sensors answered by the proximity grid instead of physics objects.
+  std::vector<SCA_NearSensor *> m_proximitySensors;
+  KX_ProximityGrid m_proximityGrid;
+
   static bool newCollisionResponse(void *client_data,
                                    void *object1,
                                    void *object2,
@@ -84,6 +90,9 @@ class KX_CollisionEventManager : public SCA_EventManager {
 
   void RemoveNewCollisions();
 
+  /// Rebuild the proximity grid and answer all the proximity sensors at once.
+  void UpdateProximitySensors();
+
  public:
   KX_CollisionEventManager(class SCA_LogicManager *logicmgr, PHY_IPhysicsEnvironment *physEnv);
   virtual ~KX_CollisionEventManager();
@@ -92,6 +101,9 @@ class KX_CollisionEventManager : public SCA_EventManager {
   virtual bool RegisterSensor(SCA_ISensor *sensor);
   virtual bool RemoveSensor(SCA_ISensor *sensor);
 
+  void AddProximitySensor(SCA_NearSensor *sensor);
+  void RemoveProximitySensor(SCA_NearSensor *sensor);
+
   SCA_LogicManager *GetLogicManager()
   {
     return m_logicmgr;
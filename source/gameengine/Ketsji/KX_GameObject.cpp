@@ -87,6 +87,7 @@ KX_GameObject::KX_GameObject(void *sgReplicationInfo, SG_Callbacks callbacks)
       m_isReplica(false),                // eevee
       m_visibleAtGameStart(false),       // eevee
       m_forceIgnoreParentTx(false),      // eevee
+      m_physicsInterpolationTime(-DBL_MAX),
       m_layer(0),
       m_lodManager(nullptr),
       m_currentLodLevel(0),
@@ -119,6 +120,11 @@ KX_GameObject::KX_GameObject(void *sgReplicationInfo, SG_Callbacks callbacks)
 
   unit_m4(m_origObmat); // eevee
   unit_m4(m_prevObmat); // eevee
+
+#ifdef WITH_PYTHON
+  std::fill(std::begin(m_mathutilsVectors), std::end(m_mathutilsVectors), nullptr);
+  std::fill(std::begin(m_mathutilsMatrices), std::end(m_mathutilsMatrices), nullptr);
+#endif
 };
 
 KX_GameObject::~KX_GameObject()
@@ -144,6 +150,8 @@ KX_GameObject::~KX_GameObject()
   if (m_components) {
     m_components->Release();
   }
+
+  ClearMathutilsCache();
 #endif  // WITH_PYTHON
 
   /* EEVEE INTEGRATION */
@@ -303,10 +311,51 @@ void KX_GameObject::ForceIgnoreParentTx()
   m_forceIgnoreParentTx = true;
 }
 
+void KX_GameObject::UpdatePhysicsInterpolation(double curtime, double framestep)
+{
+  // Don't interpolate from an outdated transform, e.g after the physics was suspended.
+  const bool reset = (curtime - m_physicsInterpolationTime) > (framestep * 1.5);
+
+  m_physicsPositions[0] = reset ? NodeGetWorldPosition() : m_physicsPositions[1];
+  m_physicsOrientations[0] = reset ? NodeGetWorldOrientation().getRotation() :
+                                     m_physicsOrientations[1];
+  m_physicsPositions[1] = NodeGetWorldPosition();
+  m_physicsOrientations[1] = NodeGetWorldOrientation().getRotation();
+  m_physicsInterpolationTime = curtime;
+}
+
+MT_Transform KX_GameObject::GetRenderTransform() const
+{
+  const KX_KetsjiEngine *engine = KX_GetActiveEngine();
+  const double factor = engine->GetPhysicsInterpolationFactor();
+  if (factor >= 1.0) {
+    return NodeGetWorldTransform();
+  }
+
+  // Only the objects updated at the last logic frame are interpolated.
+  if (m_physicsInterpolationTime != engine->GetFrameTime()) {
+    // The other objects follow the rendered transform of their parent.
+    for (SG_Node *node = m_pSGNode->GetSGParent(); node; node = node->GetSGParent()) {
+      const KX_GameObject *parent = static_cast<KX_GameObject *>(node->GetSGClientObject());
+      if (parent) {
+        MT_Transform local;
+        local.multInverseLeft(parent->NodeGetWorldTransform(), NodeGetWorldTransform());
+        return parent->GetRenderTransform() * local;
+      }
+    }
+    return NodeGetWorldTransform();
+  }
+
+  const MT_Vector3 position = m_physicsPositions[0].lerp(m_physicsPositions[1], factor);
+  const MT_Quaternion orientation = m_physicsOrientations[0].slerp(m_physicsOrientations[1],
+                                                                   factor);
+  return MT_Transform(position, MT_Matrix3x3(orientation, NodeGetWorldScaling()));
+}
+
 void KX_GameObject::TagForUpdate(bool is_overlay_pass)
 {
   float obmat[4][4];
-  NodeGetWorldTransform().getValue(&obmat[0][0]);
+  GetRenderTransform().getValue(&obmat[0][0]);
   bool staticObject = compare_m4m4(m_prevObmat, obmat, FLT_MIN);
 
   bContext *C = KX_GetActiveEngine()->GetContext();
@@ -625,7 +674,10 @@ std::string KX_GameObject::GetName()
 /* Set the name of the value */
 void KX_GameObject::SetName(const std::string &name)
 {
-  m_name = name;
+  if (name != m_name) {
+    m_name = name;
+    NameChanged();
+  }
 }
 
 PHY_IPhysicsController *KX_GameObject::GetPhysicsController()
@@ -907,6 +959,7 @@ void KX_GameObject::ProcessReplica()
   m_pClient_info->m_gameobject = this;
   m_actionManager = nullptr;
   m_state = 0;
+  m_physicsInterpolationTime = -DBL_MAX;
 
   if (m_lodManager) {
     m_lodManager->AddRef();
@@ -918,6 +971,10 @@ void KX_GameObject::ProcessReplica()
   if (m_attr_dict)
     m_attr_dict = PyDict_Copy(m_attr_dict);
 
+  // The cached objects belong to the original object proxy.
+  std::fill(std::begin(m_mathutilsVectors), std::end(m_mathutilsVectors), nullptr);
+  std::fill(std::begin(m_mathutilsMatrices), std::end(m_mathutilsMatrices), nullptr);
+
   if (m_components) {
     m_components = (CListValue<KX_PythonComponent> *)m_components->GetReplica();
     for (KX_PythonComponent *component : m_components) {
@@ -1036,17 +1093,19 @@ void KX_GameObject::ApplyTorque(const MT_Vector3 &torque, bool local)
     m_pPhysicsController->ApplyTorque(torque, local);
 }
 
-void KX_GameObject::ApplyMovement(const MT_Vector3 &dloc, bool local)
+void KX_GameObject::ApplyMovement(const MT_Vector3 &dloc, bool local, bool update)
 {
   if (m_pPhysicsController)  // (IsDynamic())
   {
     m_pPhysicsController->RelativeTranslate(dloc, local);
   }
   GetSGNode()->RelativeTranslate(dloc, GetSGNode()->GetSGParent(), local);
-  NodeUpdateGS(0.0f);
+  if (update) {
+    NodeUpdateGS(0.0f);
+  }
 }
 
-void KX_GameObject::ApplyRotation(const MT_Vector3 &drot, bool local)
+void KX_GameObject::ApplyRotation(const MT_Vector3 &drot, bool local, bool update)
 {
   MT_Matrix3x3 rotmat(drot);
 
@@ -1055,7 +1114,9 @@ void KX_GameObject::ApplyRotation(const MT_Vector3 &drot, bool local)
   if (m_pPhysicsController) {  // (IsDynamic())
     m_pPhysicsController->RelativeRotate(rotmat, local);
   }
-  NodeUpdateGS(0.0f);
+  if (update) {
+    NodeUpdateGS(0.0f);
+  }
 }
 
 void KX_GameObject::UpdateBlenderObjectMatrix(Object *blendobj)
@@ -1114,37 +1175,30 @@ KX_LodManager *KX_GameObject::GetLodManager() const
   return m_lodManager;
 }
 
-void KX_GameObject::UpdateLod(const MT_Vector3 &cam_pos, float lodfactor)
+void KX_GameObject::SetLodLevel(unsigned short level)
 {
-  if (!m_lodManager) {
-    return;
+  RAS_MeshObject *mesh = m_lodManager->GetLevel(level)->GetMesh();
+  if (mesh != m_meshes[0]) {
+    GetScene()->ReplaceMesh(this, mesh, true, false);
   }
+  m_currentLodLevel = level;
+}
 
-  KX_Scene *scene = GetScene();
-  const float distance2 = NodeGetWorldPosition().distance2(cam_pos) * (lodfactor * lodfactor);
-  KX_LodLevel *lodLevel = m_lodManager->GetLevel(scene, m_currentLodLevel, distance2);
-
-  if (lodLevel) {
-    RAS_MeshObject *mesh = lodLevel->GetMesh();
-    if (mesh != m_meshes[0]) {
-      scene->ReplaceMesh(this, mesh, true, false);
-    }
-    m_currentLodLevel = lodLevel->GetLevel();
+void KX_GameObject::UpdateLodObject(Depsgraph *depsgraph)
+{
+  Object *lodob = m_lodManager->GetLevel(m_currentLodLevel)->GetObject();
+  // The evaluated object already renders its own data.
+  if (lodob == GetBlenderObject()) {
+    return;
   }
 
-  KX_LodLevel *currentLodLevel = m_lodManager->GetLevel(m_currentLodLevel);
-  if (currentLodLevel) {
-    bContext *C = KX_GetActiveEngine()->GetContext();
-    Depsgraph *depsgraph = CTX_data_expect_evaluated_depsgraph(C);
-
-    /* Here we want to change the object which will be rendered, then the evaluated object by the
-     * depsgraph */
-    Object *ob_eval = DEG_get_evaluated_object(depsgraph, GetBlenderObject());
+  /* Here we want to change the object which will be rendered, then the evaluated object by the
+   * depsgraph */
+  Object *ob_eval = DEG_get_evaluated_object(depsgraph, GetBlenderObject());
 
-    Object *eval_lod_ob = DEG_get_evaluated_object(depsgraph, currentLodLevel->GetObject());
-    /* Try to get the object with all modifiers applied */
-    ob_eval->data = eval_lod_ob->data;
-  }
+  Object *eval_lod_ob = DEG_get_evaluated_object(depsgraph, lodob);
+  /* Try to get the object with all modifiers applied */
+  ob_eval->data = eval_lod_ob->data;
 }
 
 void KX_GameObject::UpdateTransform()
@@ -1833,20 +1887,6 @@ void KX_GameObject::SetComponents(CListValue<KX_PythonComponent> *components)
   m_components = components;
 }
 
-void KX_GameObject::UpdateComponents()
-{
-#ifdef WITH_PYTHON
-  if (!m_components) {
-    return;
-  }
-
-  for (KX_PythonComponent *comp : m_components) {
-    comp->Update();
-  }
-
-#endif  // WITH_PYTHON
-}
-
 KX_Scene *KX_GameObject::GetScene()
 {
   BLI_assert(m_pSGNode);
@@ -2091,6 +2131,81 @@ static Mathutils_Callback mathutils_kxgameob_matrix_cb = {mathutils_kxgameob_gen
                                                           nullptr,
                                                           nullptr};
 
+#endif  // USE_MATHUTILS
+
+#ifdef WITH_PYTHON
+
+/** Return true if a cached mathutils object can be reused, the object is created again
+ * when the proxy changed, e.g. after subclassing the game object. */
+static bool mathutils_kxgameob_cache_valid(PyObject *cached, PyObject *proxy)
+{
+#  ifdef USE_MATHUTILS
+  return (cached && ((BaseMathObject *)cached)->cb_user == proxy);
+#  else
+  return false;
+#  endif
+}
+
+PyObject *KX_GameObject::GetMathutilsVector(int subtype)
+{
+  PyObject *proxy = BGE_PROXY_FROM_REF_BORROW(this);
+#  ifdef USE_MATHUTILS
+  static_assert(MATHUTILS_VEC_CB_GRAVITY < ARRAY_SIZE(m_mathutilsVectors),
+                "m_mathutilsVectors must have one slot per vector callback subtype");
+#  endif
+
+  PyObject *&cached = m_mathutilsVectors[subtype];
+
+  if (!mathutils_kxgameob_cache_valid(cached, proxy)) {
+    Py_XDECREF(cached);
+#  ifdef USE_MATHUTILS
+    cached = Vector_CreatePyObject_cb(proxy, 3, mathutils_kxgameob_vector_cb_index, subtype);
+#  else
+    cached = nullptr;
+#  endif
+  }
+
+  Py_XINCREF(cached);
+  return cached;
+}
+
+PyObject *KX_GameObject::GetMathutilsMatrix(int subtype)
+{
+  PyObject *proxy = BGE_PROXY_FROM_REF_BORROW(this);
+#  ifdef USE_MATHUTILS
+  static_assert(MATHUTILS_MAT_CB_ORI_GLOBAL < ARRAY_SIZE(m_mathutilsMatrices),
+                "m_mathutilsMatrices must have one slot per matrix callback subtype");
+#  endif
+
+  PyObject *&cached = m_mathutilsMatrices[subtype];
+
+  if (!mathutils_kxgameob_cache_valid(cached, proxy)) {
+    Py_XDECREF(cached);
+#  ifdef USE_MATHUTILS
+    cached = Matrix_CreatePyObject_cb(proxy, 3, 3, mathutils_kxgameob_matrix_cb_index, subtype);
+#  else
+    cached = nullptr;
+#  endif
+  }
+
+  Py_XINCREF(cached);
+  return cached;
+}
+
+void KX_GameObject::ClearMathutilsCache()
+{
+  for (PyObject *&cached : m_mathutilsVectors) {
+    Py_CLEAR(cached);
+  }
+  for (PyObject *&cached : m_mathutilsMatrices) {
+    Py_CLEAR(cached);
+  }
+}
+
+#endif  // WITH_PYTHON
+
+#ifdef USE_MATHUTILS
+
 void KX_GameObject_Mathutils_Callback_Init(void)
 {
   // register mathutils callbacks, ok to run more than once.
@@ -2443,8 +2558,10 @@ static int Map_SetItem(PyObject *self_v, PyObject *key, PyObject *val)
       if (vallie) {
         CValue *oldprop = self->GetProperty(attr_str);
 
-        if (oldprop)
+        if (oldprop) {
           oldprop->SetValue(vallie);
+          self->PropertiesChanged();
+        }
         else
           self->SetProperty(attr_str, vallie);
 
@@ -3025,10 +3142,7 @@ PyObject *KX_GameObject::pyattr_get_worldPosition(PyObjectPlus *self_v,
                                                   const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_POS_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_POS_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetWorldPosition());
@@ -3053,10 +3167,7 @@ PyObject *KX_GameObject::pyattr_get_localPosition(PyObjectPlus *self_v,
                                                   const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_POS_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_POS_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetLocalPosition());
@@ -3081,10 +3192,7 @@ PyObject *KX_GameObject::pyattr_get_localInertia(PyObjectPlus *self_v,
                                                  const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_INERTIA_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_INERTIA_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   if (self->GetPhysicsController1())
@@ -3097,11 +3205,7 @@ PyObject *KX_GameObject::pyattr_get_worldOrientation(PyObjectPlus *self_v,
                                                      const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Matrix_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  3,
-                                  mathutils_kxgameob_matrix_cb_index,
-                                  MATHUTILS_MAT_CB_ORI_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsMatrix(MATHUTILS_MAT_CB_ORI_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetWorldOrientation());
@@ -3129,11 +3233,7 @@ PyObject *KX_GameObject::pyattr_get_localOrientation(PyObjectPlus *self_v,
                                                      const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Matrix_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  3,
-                                  mathutils_kxgameob_matrix_cb_index,
-                                  MATHUTILS_MAT_CB_ORI_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsMatrix(MATHUTILS_MAT_CB_ORI_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetLocalOrientation());
@@ -3160,10 +3260,7 @@ PyObject *KX_GameObject::pyattr_get_worldScaling(PyObjectPlus *self_v,
                                                  const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_SCALE_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_SCALE_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetWorldScaling());
@@ -3188,10 +3285,7 @@ PyObject *KX_GameObject::pyattr_get_localScaling(PyObjectPlus *self_v,
                                                  const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_SCALE_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_SCALE_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetLocalScaling());
@@ -3290,10 +3384,7 @@ PyObject *KX_GameObject::pyattr_get_worldLinearVelocity(PyObjectPlus *self_v,
                                                         const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_LINVEL_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_LINVEL_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(GetLinearVelocity(false));
@@ -3318,10 +3409,7 @@ PyObject *KX_GameObject::pyattr_get_localLinearVelocity(PyObjectPlus *self_v,
                                                         const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_LINVEL_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_LINVEL_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(GetLinearVelocity(true));
@@ -3346,10 +3434,7 @@ PyObject *KX_GameObject::pyattr_get_worldAngularVelocity(PyObjectPlus *self_v,
                                                          const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_ANGVEL_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_ANGVEL_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(GetAngularVelocity(false));
@@ -3374,10 +3459,7 @@ PyObject *KX_GameObject::pyattr_get_localAngularVelocity(PyObjectPlus *self_v,
                                                          const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_ANGVEL_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_ANGVEL_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(GetAngularVelocity(true));
@@ -3402,10 +3484,7 @@ PyObject *KX_GameObject::pyattr_get_gravity(PyObjectPlus *self_v,
                                             const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_GRAVITY);
+  return static_cast<KX_GameObject *>(self_v)->GetMathutilsVector(MATHUTILS_VEC_CB_GRAVITY);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(GetGravity());
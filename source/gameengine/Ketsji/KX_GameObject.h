@@ -97,6 +97,12 @@ class KX_GameObject : public SCA_IObject {
   bool m_forceIgnoreParentTx;
   /* END OF EEVEE INTEGRATION */
 
+  /// World transforms of the two last logic frames used to interpolate the rendered transform.
+  MT_Vector3 m_physicsPositions[2];
+  MT_Quaternion m_physicsOrientations[2];
+  /// Logic frame time of the last stored transform.
+  double m_physicsInterpolationTime;
+
   KX_ClientObjectInfo *m_pClient_info;
   std::string m_name;
   int m_layer;
@@ -139,6 +145,12 @@ class KX_GameObject : public SCA_IObject {
   /* EEVEE INTEGRATION */
 
   void TagForUpdate(bool is_overlay_pass);
+  /** Store the world transform computed at the logic frame curtime, the transform rendered
+   * is interpolated between the two last stored transforms.
+   */
+  void UpdatePhysicsInterpolation(double curtime, double framestep);
+  /// Return the world transform to render, interpolated if needed.
+  MT_Transform GetRenderTransform() const;
   void ReplicateBlenderObject();
   void HideOriginalObject();
   void RemoveReplicaObject();
@@ -192,6 +204,14 @@ class KX_GameObject : public SCA_IObject {
   PyObject *m_attr_dict;
   PyObject *m_collisionCallbacks;
   PyObject *m_removeCallbacks;
+
+  /** Mathutils callback objects returned by the vector and matrix attributes, indexed by
+   * callback subtype (MATHUTILS_VEC_CB_* and MATHUTILS_MAT_CB_* in KX_GameObject.cpp, checked
+   * there by static asserts). Their values are always read from the object so they are created
+   * once and shared by every access.
+   */
+  PyObject *m_mathutilsVectors[12];
+  PyObject *m_mathutilsMatrices[3];
 #endif
 
   virtual void /* This function should be virtual - derived classed override it */
@@ -267,6 +287,14 @@ class KX_GameObject : public SCA_IObject {
                   float playback_speed = 1.f,
                   short blend_mode = 0);
 
+  /**
+   * Gets the action manager, nullptr if the object never played an action
+   */
+  BL_ActionManager *GetExistingActionManager() const
+  {
+    return m_actionManager;
+  }
+
   /**
    * Gets the current frame of an action
    */
@@ -559,9 +587,11 @@ class KX_GameObject : public SCA_IObject {
 
   void ApplyTorque(const MT_Vector3 &torque, bool local);
 
-  void ApplyRotation(const MT_Vector3 &drot, bool local);
+  /// Rotate the object, the world transform is not updated when update is false.
+  void ApplyRotation(const MT_Vector3 &drot, bool local, bool update = true);
 
-  void ApplyMovement(const MT_Vector3 &dloc, bool local);
+  /// Move the object, the world transform is not updated when update is false.
+  void ApplyMovement(const MT_Vector3 &dloc, bool local, bool update = true);
 
   void addLinearVelocity(const MT_Vector3 &lin_vel, bool local);
 
@@ -639,10 +669,17 @@ class KX_GameObject : public SCA_IObject {
   /// Get current lod manager.
   KX_LodManager *GetLodManager() const;
 
-  /**
-   * Updates the current lod level based on distance from camera.
+  /// Get the current lod level index.
+  unsigned short GetLodLevel() const
+  {
+    return m_currentLodLevel;
+  }
+  /** Set the current lod level, the mesh is replaced if the level uses a different one.
+   * \param level The lod level index, must be valid for the current lod manager.
    */
-  void UpdateLod(const MT_Vector3 &cam_pos, float lodfactor);
+  void SetLodLevel(unsigned short level);
+  /// Render the evaluated data of the current lod level object instead of the object data.
+  void UpdateLodObject(struct Depsgraph *depsgraph);
 
   /**
    * Pick out a mesh associated with the integer 'num'.
@@ -746,12 +783,17 @@ class KX_GameObject : public SCA_IObject {
   CListValue<KX_PythonComponent> *GetComponents() const;
   /// Add a components.
   void SetComponents(CListValue<KX_PythonComponent> *components);
-  /// Updates the components.
-  void UpdateComponents();
 
   KX_Scene *GetScene();
 
 #ifdef WITH_PYTHON
+  /// Return a new reference to the cached mathutils 3D vector of a callback subtype.
+  PyObject *GetMathutilsVector(int subtype);
+  /// Return a new reference to the cached mathutils matrix of a callback subtype.
+  PyObject *GetMathutilsMatrix(int subtype);
+  /// Release the cached mathutils objects.
+  void ClearMathutilsCache();
+
   /**
    * \section Python interface functions.
    */
@@ -36,6 +36,8 @@
 
 #include "KX_KetsjiEngine.h"
 
+#include <algorithm>
+
 #include <boost/format.hpp>
 
 #include "DNA_scene_types.h"
@@ -52,6 +54,7 @@
 #include "KX_NetworkMessageScene.h"
 #include "KX_PyConstraintBinding.h"
 #include "KX_PythonInit.h"  // for updatePythonJoysticks
+#include "KX_SoundManager.h"
 #include "PHY_IPhysicsEnvironment.h"
 #include "RAS_ICanvas.h"
 #include "SCA_IInputDevice.h"
@@ -124,6 +127,7 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
       m_rasterizer(nullptr),
       m_kxsystem(system),
       m_converter(nullptr),
+      m_soundManager(new KX_SoundManager()),
       m_inputDevice(nullptr),
       m_bInitialized(false),
       m_flags(AUTO_ADD_DEBUG_PROPERTIES),
@@ -132,6 +136,7 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
       m_previousAnimTime(0.0f),
       m_timescale(1.0f),
       m_previousRealTime(0.0f),
+      m_physicsInterpolationFactor(1.0),
       m_maxLogicFrame(5),
       m_maxPhysicsFrame(5),
       m_ticrate(DEFAULT_LOGIC_TIC_RATE),
@@ -170,6 +175,8 @@ KX_KetsjiEngine::~KX_KetsjiEngine()
 #endif
 
   m_scenes->Release();
+
+  delete m_soundManager;
 }
 
 /* EEVEE integration */
@@ -407,7 +414,10 @@ bool KX_KetsjiEngine::NextFrame()
     frames = m_maxPhysicsFrame;
   }
 
-  bool doRender = frames > 0;
+  /* With a fixed framerate the rendering can be done between two logic frames, the physics
+   * objects are then rendered between their transforms of the two last logic frames. */
+  const bool interpolate = (m_flags & FIXED_FRAMERATE) && (m_flags & PHYSICS_INTERPOLATION);
+  bool doRender = frames > 0 || interpolate;
 
   if (frames > m_maxLogicFrame) {
     framestep = (frames * timestep) / m_maxLogicFrame;
@@ -485,9 +495,16 @@ bool KX_KetsjiEngine::NextFrame()
       m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
       scene->UpdateParents(m_frameTime);
 
+      if (interpolate) {
+        scene->UpdatePhysicsInterpolation(m_frameTime, framestep);
+      }
+
       m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
     }
 
+    // Send the 3D sound parameters submitted by the actuators of all the scenes at once.
+    m_soundManager->Flush();
+
     m_logger.StartLog(tc_network, m_kxsystem->GetTimeInSeconds());
     m_networkMessageManager->ClearMessages();
 
@@ -502,6 +519,15 @@ bool KX_KetsjiEngine::NextFrame()
 
   }
 
+  if (interpolate) {
+    // The remaining time is less than a logic frame, except when skipped by max logic frame.
+    const double factor = (m_clockTime - m_frameTime) / framestep;
+    m_physicsInterpolationFactor = std::min(std::max(factor, 0.0), 1.0);
+  }
+  else {
+    m_physicsInterpolationFactor = 1.0;
+  }
+
   // Start logging time spent outside main loop
   m_logger.StartLog(tc_outside, m_kxsystem->GetTimeInSeconds());
 
@@ -700,6 +726,21 @@ void KX_KetsjiEngine::Render()
   KX_Scene *firstscene = m_scenes->GetFront();
   const RAS_FrameSettings &framesettings = firstscene->GetFramingType();
 
+  // The animations don't depend on the camera, update them once before the render of all views.
+  m_logger.StartLog(tc_animations, m_kxsystem->GetTimeInSeconds());
+  if (m_flags & RESTRICT_ANIMATION) {
+    // All the scenes are updated together at the animation frame rate.
+    KX_SetActiveScene(firstscene);
+    UpdateAnimations(firstscene);
+  }
+  else {
+    for (KX_Scene *scene : m_scenes) {
+      KX_SetActiveScene(scene);
+      UpdateAnimations(scene);
+    }
+  }
+  m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
+
   // Used to detect when a camera is the first rendered an then doesn't request a depth clear.
   unsigned short pass = 0;
 
@@ -724,6 +765,11 @@ void KX_KetsjiEngine::Render()
       }
     }
   }
+
+  for (KX_Scene *scene : m_scenes) {
+    scene->EndRender();
+  }
+
   Scene *first_scene = m_scenes->GetFront()->GetBlenderScene();
   if (!(first_scene->gm.flag & GAME_USE_VIEWPORT_RENDER)) {
     int v[4];
@@ -967,13 +1013,6 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene,
 
   m_rasterizer->SetEye(RAS_Rasterizer::RAS_STEREO_LEFTEYE /*cameraFrameData.m_eye*/);
 
-  m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
-
-  m_logger.StartLog(tc_animations, m_kxsystem->GetTimeInSeconds());
-  UpdateAnimations(scene);
-
-  m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
-
 #ifdef WITH_PYTHON
   PHY_SetActiveEnvironment(scene->GetPhysicsEnvironment());
   // Run any pre-drawing python callbacks
@@ -1166,6 +1205,14 @@ void KX_KetsjiEngine::RenderDebugProperties()
           MT_Vector2(xcoord + (int)(2.2 * profile_indent), ycoord), boxSize, white);
       ycoord += const_ysize;
     }
+
+    const KX_SoundManager::Stats &soundStats = m_soundManager->GetStats();
+    debugDraw.RenderText2D("Sounds:", MT_Vector2(xcoord + const_xindent, ycoord), white);
+    debugtxt = (boost::format("%d 3D | %d culled") % soundStats.m_sources % soundStats.m_culled)
+                   .str();
+    debugDraw.RenderText2D(
+        debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+    ycoord += const_ysize;
   }
   // Add the ymargin for titles below the other section of debug info
   ycoord += title_y_top_margin;
@@ -1422,6 +1469,11 @@ double KX_KetsjiEngine::GetFrameTime(void) const
   return m_frameTime;
 }
 
+double KX_KetsjiEngine::GetPhysicsInterpolationFactor() const
+{
+  return m_physicsInterpolationFactor;
+}
+
 double KX_KetsjiEngine::GetRealTime(void) const
 {
   return m_kxsystem->GetTimeInSeconds();
@@ -48,6 +48,7 @@ struct TaskScheduler;
 class KX_ISystem;
 class BL_BlenderConverter;
 class KX_NetworkMessageManager;
+class KX_SoundManager;
 class RAS_ICanvas;
 class RAS_FrameBuffer;
 class SCA_IInputDevice;
@@ -92,7 +93,9 @@ class KX_KetsjiEngine {
     /// Automatic add debug properties to the debug list.
     AUTO_ADD_DEBUG_PROPERTIES = (1 << 6),
     /// Use override camera?
-    CAMERA_OVERRIDE = (1 << 7)
+    CAMERA_OVERRIDE = (1 << 7),
+    /// Interpolate the rendered transforms of the physics objects between logic frames?
+    PHYSICS_INTERPOLATION = (1 << 8)
   };
 
  private:
@@ -137,6 +140,8 @@ class KX_KetsjiEngine {
   KX_ISystem *m_kxsystem;
   BL_BlenderConverter *m_converter;
   KX_NetworkMessageManager *m_networkMessageManager;
+  /// Batch of the 3D sound updates of the logic frame.
+  KX_SoundManager *m_soundManager;
 #ifdef WITH_PYTHON
   PyObject *m_pyprofiledict;
 #endif
@@ -165,6 +170,8 @@ class KX_KetsjiEngine {
   /// slower than real-time.
   double m_timescale;
   double m_previousRealTime;
+  /// Fraction of a logic frame elapsed since the last logic frame, 1.0 without interpolation.
+  double m_physicsInterpolationFactor;
 
   /// maximum number of consecutive logic frame
   int m_maxLogicFrame;
@@ -318,6 +325,10 @@ class KX_KetsjiEngine {
   {
     return m_networkMessageManager;
   }
+  KX_SoundManager *GetSoundManager() const
+  {
+    return m_soundManager;
+  }
 
   /// returns true if an update happened to indicate -> Render
   bool NextFrame();
@@ -379,6 +390,12 @@ class KX_KetsjiEngine {
    */
   double GetFrameTime(void) const;
 
+  /**
+   * Returns the factor used to interpolate the rendered physics transforms between the two
+   * last logic frames, 1.0 when the last logic frame is rendered as it is.
+   */
+  double GetPhysicsInterpolationFactor() const;
+
   /**
    * Returns the real (system) time
    */
@@ -26,6 +26,8 @@
 
 #include "KX_LibLoadStatus.h"
 
+#include "BL_BlenderConverter.h"
+
 #include "PIL_time.h"
 
 KX_LibLoadStatus::KX_LibLoadStatus(class BL_BlenderConverter *kx_converter,
@@ -38,7 +40,11 @@ KX_LibLoadStatus::KX_LibLoadStatus(class BL_BlenderConverter *kx_converter,
       m_data(nullptr),
       m_libname(path),
       m_progress(0.0f),
-      m_finished(false)
+      m_phase(PHASE_READ),
+      m_sceneCount(0),
+      m_priority(0),
+      m_finished(false),
+      m_cancelled(false)
 #ifdef WITH_PYTHON
       ,
       m_finish_cb(nullptr),
@@ -51,6 +57,7 @@ KX_LibLoadStatus::KX_LibLoadStatus(class BL_BlenderConverter *kx_converter,
 void KX_LibLoadStatus::Finish()
 {
   m_finished = true;
+  m_phase = PHASE_FINISHED;
   m_progress = 1.f;
   m_endtime = PIL_check_seconds_timer();
 
@@ -120,6 +127,41 @@ void *KX_LibLoadStatus::GetData()
   return m_data;
 }
 
+void KX_LibLoadStatus::SetCancelled()
+{
+  m_cancelled = true;
+}
+
+KX_LibLoadStatus::Phase KX_LibLoadStatus::GetPhase() const
+{
+  return m_phase;
+}
+
+void KX_LibLoadStatus::SetPhase(Phase phase)
+{
+  m_phase = phase;
+}
+
+unsigned int KX_LibLoadStatus::GetSceneCount() const
+{
+  return m_sceneCount;
+}
+
+void KX_LibLoadStatus::SetSceneCount(unsigned int count)
+{
+  m_sceneCount = count;
+}
+
+int KX_LibLoadStatus::GetPriority() const
+{
+  return m_priority;
+}
+
+void KX_LibLoadStatus::SetPriority(int priority)
+{
+  m_priority = priority;
+}
+
 void KX_LibLoadStatus::SetProgress(float progress)
 {
   m_progress = progress;
@@ -140,6 +182,7 @@ void KX_LibLoadStatus::AddProgress(float progress)
 #ifdef WITH_PYTHON
 
 PyMethodDef KX_LibLoadStatus::Methods[] = {
+    KX_PYMETHODTABLE_NOARGS(KX_LibLoadStatus, cancel),
     {nullptr, nullptr}  // Sentinel
 };
 
@@ -152,6 +195,9 @@ PyAttributeDef KX_LibLoadStatus::Attributes[] = {
     KX_PYATTRIBUTE_STRING_RO("libraryName", KX_LibLoadStatus, m_libname),
     KX_PYATTRIBUTE_RO_FUNCTION("timeTaken", KX_LibLoadStatus, pyattr_get_timetaken),
     KX_PYATTRIBUTE_BOOL_RO("finished", KX_LibLoadStatus, m_finished),
+    KX_PYATTRIBUTE_RO_FUNCTION("cancelled", KX_LibLoadStatus, pyattr_get_cancelled),
+    KX_PYATTRIBUTE_INT_RO("priority", KX_LibLoadStatus, m_priority),
+    KX_PYATTRIBUTE_RO_FUNCTION("phase", KX_LibLoadStatus, pyattr_get_phase),
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
@@ -266,4 +312,30 @@ PyObject *KX_LibLoadStatus::pyattr_get_timetaken(PyObjectPlus *self_v,
 
   return PyFloat_FromDouble(self->m_endtime - self->m_starttime);
 }
+
+PyObject *KX_LibLoadStatus::pyattr_get_phase(PyObjectPlus *self_v,
+                                             const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_LibLoadStatus *self = static_cast<KX_LibLoadStatus *>(self_v);
+
+  static const char *names[] = {"READ", "CONVERT", "MERGE", "FINISHED"};
+  return PyUnicode_FromString(names[self->GetPhase()]);
+}
+
+PyObject *KX_LibLoadStatus::pyattr_get_cancelled(PyObjectPlus *self_v,
+                                                 const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_LibLoadStatus *self = static_cast<KX_LibLoadStatus *>(self_v);
+
+  return PyBool_FromLong(self->m_converter->IsAsyncLoadCancelled(self));
+}
+
+KX_PYMETHODDEF_DOC_NOARGS(KX_LibLoadStatus,
+                          cancel,
+                          "cancel()\n"
+                          "Cancel an asynchronous libload, the scenes not yet merged are discarded.\n")
+{
+  m_converter->CancelAsyncLoad(this);
+  Py_RETURN_NONE;
+}
 #endif  // WITH_PYTHON
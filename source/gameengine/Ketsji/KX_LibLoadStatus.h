@@ -30,7 +30,14 @@
 #include "EXP_PyObjectPlus.h"
 
 class KX_LibLoadStatus : public PyObjectPlus {
-  Py_Header private : class BL_BlenderConverter *m_converter;
+  Py_Header
+
+ public:
+  /// The loading phases of a libload, in execution order.
+  enum Phase { PHASE_READ = 0, PHASE_CONVERT, PHASE_MERGE, PHASE_FINISHED };
+
+ private:
+  class BL_BlenderConverter *m_converter;
   class KX_KetsjiEngine *m_engine;
   class KX_Scene *m_mergescene;
   void *m_data;
@@ -40,8 +47,16 @@ class KX_LibLoadStatus : public PyObjectPlus {
   double m_starttime;
   double m_endtime;
 
+  Phase m_phase;
+  /// Number of scenes converted and merged by this libload, used for progress.
+  unsigned int m_sceneCount;
+  /// Higher priority libloads are converted and merged first.
+  int m_priority;
+
   // The current status of this libload, used by the scene converter.
   bool m_finished;
+  /// Set when the libload was cancelled, accessed under the scene converter lock.
+  bool m_cancelled;
 
 #ifdef WITH_PYTHON
   PyObject *m_finish_cb;
@@ -70,6 +85,21 @@ class KX_LibLoadStatus : public PyObjectPlus {
     return m_finished;
   }
 
+  inline bool IsCancelled() const
+  {
+    return m_cancelled;
+  }
+  void SetCancelled();
+
+  Phase GetPhase() const;
+  void SetPhase(Phase phase);
+
+  unsigned int GetSceneCount() const;
+  void SetSceneCount(unsigned int count);
+
+  int GetPriority() const;
+  void SetPriority(int priority);
+
   void SetProgress(float progress);
   float GetProgress();
   void AddProgress(float progress);
@@ -85,6 +115,10 @@ class KX_LibLoadStatus : public PyObjectPlus {
                                    PyObject *value);
 
   static PyObject *pyattr_get_timetaken(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+  static PyObject *pyattr_get_phase(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+  static PyObject *pyattr_get_cancelled(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+
+  KX_PYMETHOD_DOC_NOARGS(KX_LibLoadStatus, cancel);
 #endif
 };
 
@@ -26,6 +26,8 @@
 
 #include "KX_LodManager.h"
 
+#include <limits>
+
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "DNA_object_types.h"
@@ -35,72 +37,17 @@
 #include "KX_LodLevel.h"
 #include "KX_Scene.h"
 
-KX_LodManager::LodLevelIterator::LodLevelIterator(const std::vector<KX_LodLevel *> &levels,
-                                                  unsigned short index,
-                                                  KX_Scene *scene)
-    : m_levels(levels), m_index(index), m_scene(scene)
-{
-}
-
-inline float KX_LodManager::LodLevelIterator::GetHysteresis(unsigned short level) const
-{
-  if (level < 1 || !m_scene->IsActivedLodHysteresis()) {
-    return 0.0f;
-  }
-
-  KX_LodLevel *lod = m_levels[level];
-  KX_LodLevel *prelod = m_levels[level - 1];
-
-  float hysteresis = 0.0f;
-  // if exists, LoD level hysteresis will override scene hysteresis
-  if (lod->GetFlag() & KX_LodLevel::USE_HYSTERESIS) {
-    hysteresis = lod->GetHysteresis() / 100.0f;
-  }
-  else {
-    hysteresis = m_scene->GetLodHysteresisValue() / 100.0f;
-  }
-
-  return MT_abs(prelod->GetDistance() - lod->GetDistance()) * hysteresis;
-}
-
-inline int KX_LodManager::LodLevelIterator::operator++()
-{
-  return m_index++;
-}
-
-inline int KX_LodManager::LodLevelIterator::operator--()
-{
-  return m_index--;
-}
-
-inline short KX_LodManager::LodLevelIterator::operator*() const
-{
-  return m_index;
-}
-
-inline bool KX_LodManager::LodLevelIterator::operator<=(float distance2) const
-{
-  // The last level doesn't have a next level, then the maximum distance is infinite and should
-  // always return false.
-  if (m_index == (m_levels.size() - 1)) {
-    return false;
-  }
-
-  return square_f(m_levels[m_index + 1]->GetDistance() + GetHysteresis(m_index + 1)) <= distance2;
-}
-
-inline bool KX_LodManager::LodLevelIterator::operator>(float distance2) const
-{
-  return square_f(m_levels[m_index]->GetDistance() - GetHysteresis(m_index)) > distance2;
-}
-
 KX_LodManager::KX_LodManager(Object *ob,
                              KX_Scene *scene,
                              RAS_Rasterizer *rasty,
                              BL_BlenderSceneConverter *converter,
                              bool libloading,
                              bool converting_during_runtime)
-    : m_refcount(1), m_distanceFactor(1.0f)
+    : m_hysteresisActive(false),
+      m_hysteresisValue(0),
+      m_distancesValid(false),
+      m_refcount(1),
+      m_distanceFactor(1.0f)
 {
   if (BLI_listbase_count_at_most(&ob->lodlevels, 2) > 1) {
     Mesh *lodmesh = (Mesh *)ob->data;
@@ -139,7 +86,12 @@ KX_LodManager::KX_LodManager(Object *ob,
   }
 }
 
-KX_LodManager::KX_LodManager(RAS_MeshObject *meshObj, Object *lodsource) : m_refcount(1), m_distanceFactor(1.0f)
+KX_LodManager::KX_LodManager(RAS_MeshObject *meshObj, Object *lodsource)
+    : m_hysteresisActive(false),
+      m_hysteresisValue(0),
+      m_distancesValid(false),
+      m_refcount(1),
+      m_distanceFactor(1.0f)
 {
   KX_LodLevel *lodLevel = new KX_LodLevel(
       0.0f, 0.0f, 0, meshObj, lodsource, OB_LOD_USE_MESH | OB_LOD_USE_MAT);
@@ -168,6 +120,51 @@ KX_LodLevel *KX_LodManager::GetLevel(unsigned int index) const
   return m_levels[index];
 }
 
+float KX_LodManager::GetHysteresis(KX_Scene *scene, unsigned short level)
+{
+  if (level < 1 || !scene->IsActivedLodHysteresis()) {
+    return 0.0f;
+  }
+
+  KX_LodLevel *lod = m_levels[level];
+  KX_LodLevel *prelod = m_levels[level - 1];
+
+  float hysteresis = 0.0f;
+  // if exists, LoD level hysteresis will override scene hysteresis
+  if (lod->GetFlag() & KX_LodLevel::USE_HYSTERESIS) {
+    hysteresis = lod->GetHysteresis() / 100.0f;
+  }
+  else {
+    hysteresis = scene->GetLodHysteresisValue() / 100.0f;
+  }
+
+  return MT_abs(prelod->GetDistance() - lod->GetDistance()) * hysteresis;
+}
+
+void KX_LodManager::UpdateDistances(KX_Scene *scene)
+{
+  const bool hysteresisActive = scene->IsActivedLodHysteresis();
+  const int hysteresisValue = scene->GetLodHysteresisValue();
+  if (m_distancesValid && hysteresisActive == m_hysteresisActive &&
+      hysteresisValue == m_hysteresisValue) {
+    return;
+  }
+
+  const unsigned short count = m_levels.size();
+  m_upDistances2.resize(count);
+  m_downDistances2.resize(count);
+  for (unsigned short i = 0; i < count; ++i) {
+    m_upDistances2[i] = (i == (count - 1)) ?
+                            std::numeric_limits<float>::infinity() :
+                            square_f(m_levels[i + 1]->GetDistance() + GetHysteresis(scene, i + 1));
+    m_downDistances2[i] = square_f(m_levels[i]->GetDistance() - GetHysteresis(scene, i));
+  }
+
+  m_hysteresisActive = hysteresisActive;
+  m_hysteresisValue = hysteresisValue;
+  m_distancesValid = true;
+}
+
 KX_LodLevel *KX_LodManager::GetLevel(KX_Scene *scene, short previouslod, float distance2)
 {
   if (m_levels.size() == 1) {
@@ -175,22 +172,46 @@ KX_LodLevel *KX_LodManager::GetLevel(KX_Scene *scene, short previouslod, float d
   }
   distance2 *= (m_distanceFactor * m_distanceFactor);
 
-  LodLevelIterator it(m_levels, previouslod, scene);
+  const unsigned short level = GetLevelIndex(scene, max_ii(previouslod, 0), distance2);
+  return (level == previouslod) ? nullptr : m_levels[level];
+}
 
-  while (true) {
-    if (it <= distance2) {
-      ++it;
-    }
-    else if (it > distance2) {
-      --it;
-    }
-    else {
-      break;
-    }
+unsigned short KX_LodManager::GetLevelIndex(KX_Scene *scene,
+                                            unsigned short previouslod,
+                                            float distance2)
+{
+  UpdateDistances(scene);
+
+  const unsigned short last = m_levels.size() - 1;
+  unsigned short level = min_ii(previouslod, last);
+  /* The hysteresis ranges of two consecutive levels never overlap, then only one of the loops
+   * can move the level. */
+  while (level < last && m_upDistances2[level] <= distance2) {
+    ++level;
+  }
+  while (level > 0 && m_downDistances2[level] > distance2) {
+    --level;
   }
 
-  const unsigned short level = *it;
-  return (level == previouslod) ? nullptr : m_levels[level];
+  return level;
+}
+
+void KX_LodManager::GetLevelDistances(KX_Scene *scene,
+                                      unsigned short level,
+                                      float &up2,
+                                      float &down2)
+{
+  UpdateDistances(scene);
+
+  level = min_ii(level, m_levels.size() - 1);
+  up2 = m_upDistances2[level];
+  // The first level never switches to a previous level.
+  down2 = (level > 0) ? m_downDistances2[level] : -1.0f;
+}
+
+float KX_LodManager::GetDistanceFactor() const
+{
+  return m_distanceFactor;
 }
 
 #ifdef WITH_PYTHON
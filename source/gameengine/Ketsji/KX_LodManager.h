@@ -40,32 +40,7 @@ struct Object;
 class KX_LodManager : public CValue {
   Py_Header
 
-      private :
-      /** This class helps to compare the object distance to camera with the list of lod levels.
-       * It represent the gap between two levels, when you compare it with a distance it compare
-       * with the a N level distance and a N+1 level distance including hysteresis.
-       */
-      class LodLevelIterator {
-   private:
-    const std::vector<KX_LodLevel *> &m_levels;
-    short m_index;
-    KX_Scene *m_scene;
-    float GetHysteresis(unsigned short level) const;
-
-   public:
-    LodLevelIterator(const std::vector<KX_LodLevel *> &levels,
-                     unsigned short index,
-                     KX_Scene *scene);
-
-    int operator++();
-    int operator--();
-    short operator*() const;
-    /// Compare next level distance more hysteresis with current distance.
-    bool operator<=(float distance2) const;
-    /// Compare the current lod level distance less hysteresis with current distance.
-    bool operator>(float distance2) const;
-  };
-
+ private:
   std::vector<KX_LodLevel *> m_levels;
 
   /** Get the hysteresis from the level or the scene.
@@ -74,6 +49,20 @@ class KX_LodManager : public CValue {
    */
   float GetHysteresis(KX_Scene *scene, unsigned short level);
 
+  /** Squared distances from which a level switches to the next level, hysteresis included.
+   * The last level never switches and uses an infinite distance.
+   */
+  std::vector<float> m_upDistances2;
+  /// Squared distances under which a level switches to the previous level, hysteresis included.
+  std::vector<float> m_downDistances2;
+  /// Scene hysteresis settings used to compute the level distances.
+  bool m_hysteresisActive;
+  int m_hysteresisValue;
+  bool m_distancesValid;
+
+  /// Compute the level distances again if the scene hysteresis settings changed.
+  void UpdateDistances(KX_Scene *scene);
+
   int m_refcount;
 
   /// Factor applied to the distance from the camera to the object.
@@ -107,6 +96,24 @@ class KX_LodManager : public CValue {
    */
   KX_LodLevel *GetLevel(KX_Scene *scene, short previouslod, float distance);
 
+  /** Get the index of the lod level cooresponding to a distance and previous level.
+   * \param scene Scene used to get default hysteresis.
+   * \param previouslod Previous lod level index.
+   * \param distance2 Squared distance object to the camera, scaled by the distance factors.
+   */
+  unsigned short GetLevelIndex(KX_Scene *scene, unsigned short previouslod, float distance2);
+
+  /** Get the squared distance range in which a lod level is kept.
+   * \param scene Scene used to get default hysteresis.
+   * \param level The lod level index.
+   * \param up2 Set to the squared distance from which the next level is used.
+   * \param down2 Set to the squared distance under which the previous level is used.
+   */
+  void GetLevelDistances(KX_Scene *scene, unsigned short level, float &up2, float &down2);
+
+  /// Return the factor applied to the distance from the camera to the object.
+  float GetDistanceFactor() const;
+
 #ifdef WITH_PYTHON
 
   static PyObject *pyattr_get_levels(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
@@ -0,0 +1,128 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_ProximityGrid.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_ProximityGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// Cells coordinates are packed on 21 bits per axis.
+static const int cellCoordMax = (1 << 20) - 1;
+
+KX_ProximityGrid::KX_ProximityGrid() : m_cellSize(1.0f), m_maxRadius(0.0f)
+{
+}
+
+int KX_ProximityGrid::GetCellCoord(float value) const
+{
+  const float coord = floorf(value / m_cellSize);
+  return (int)std::max(-(float)cellCoordMax, std::min(coord, (float)cellCoordMax));
+}
+
+uint64_t KX_ProximityGrid::GetCellKey(int x, int y, int z)
+{
+  const uint64_t mask = (1 << 21) - 1;
+  return ((uint64_t)(x & mask) << 42) | ((uint64_t)(y & mask) << 21) | (uint64_t)(z & mask);
+}
+
+void KX_ProximityGrid::Build(std::vector<Entry> &entries, float cellSize)
+{
+  m_cellSize = cellSize;
+  m_maxRadius = 0.0f;
+  m_cells.clear();
+
+  std::vector<std::pair<uint64_t, unsigned int>> keys(entries.size());
+  for (unsigned int i = 0, size = entries.size(); i < size; ++i) {
+    const Entry &entry = entries[i];
+    const MT_Vector3 &pos = entry.m_position;
+    keys[i] = {GetCellKey(GetCellCoord(pos.x()), GetCellCoord(pos.y()), GetCellCoord(pos.z())),
+               i};
+    m_maxRadius = std::max(m_maxRadius, entry.m_radius);
+  }
+
+  std::sort(keys.begin(), keys.end());
+
+  m_entries.resize(entries.size());
+  for (unsigned int i = 0, size = keys.size(); i < size; ++i) {
+    m_entries[i] = entries[keys[i].second];
+
+    const uint64_t key = keys[i].first;
+    if (i == 0 || keys[i - 1].first != key) {
+      m_cells[key] = {i, i + 1};
+    }
+    else {
+      ++m_cells[key].second;
+    }
+  }
+
+  entries.clear();
+}
+
+void KX_ProximityGrid::Clear()
+{
+  m_entries.clear();
+  m_cells.clear();
+  m_maxRadius = 0.0f;
+}
+
+void KX_ProximityGrid::Query(const MT_Vector3 &center,
+                             float radius,
+                             std::vector<const Entry *> &result) const
+{
+  if (m_entries.empty()) {
+    return;
+  }
+
+  const float extent = radius + m_maxRadius;
+  const int min[3] = {GetCellCoord(center.x() - extent),
+                      GetCellCoord(center.y() - extent),
+                      GetCellCoord(center.z() - extent)};
+  const int max[3] = {GetCellCoord(center.x() + extent),
+                      GetCellCoord(center.y() + extent),
+                      GetCellCoord(center.z() + extent)};
+
+  const uint64_t numCells = (uint64_t)(max[0] - min[0] + 1) * (max[1] - min[1] + 1) *
+                            (max[2] - min[2] + 1);
+  // A query larger than the grid content is faster by testing all the entries.
+  if (numCells > m_cells.size()) {
+    for (const Entry &entry : m_entries) {
+      result.push_back(&entry);
+    }
+    return;
+  }
+
+  for (int x = min[0]; x <= max[0]; ++x) {
+    for (int y = min[1]; y <= max[1]; ++y) {
+      for (int z = min[2]; z <= max[2]; ++z) {
+        const auto it = m_cells.find(GetCellKey(x, y, z));
+        if (it == m_cells.end()) {
+          continue;
+        }
+        for (unsigned int i = it->second.first; i < it->second.second; ++i) {
+          result.push_back(&m_entries[i]);
+        }
+      }
+    }
+  }
+}
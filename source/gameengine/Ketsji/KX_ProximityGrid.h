@@ -0,0 +1,72 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_ProximityGrid.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "MT_Vector3.h"
+
+class KX_GameObject;
+
+/** \brief Uniform grid of object bounding spheres, rebuilt every frame to answer the proximity
+ * queries of the near and radar sensors without physics objects.
+ * Each object is stored in the cell containing its center, the queries are then expanded
+ * by the largest object radius.
+ */
+class KX_ProximityGrid {
+ public:
+  struct Entry {
+    KX_GameObject *m_object;
+    MT_Vector3 m_position;
+    float m_radius;
+  };
+
+ private:
+  float m_cellSize;
+  float m_maxRadius;
+  /// Entries sorted by cell.
+  std::vector<Entry> m_entries;
+  /// Range of the entries of each non-empty cell.
+  std::unordered_map<uint64_t, std::pair<unsigned int, unsigned int>> m_cells;
+
+  int GetCellCoord(float value) const;
+  static uint64_t GetCellKey(int x, int y, int z);
+
+ public:
+  KX_ProximityGrid();
+  ~KX_ProximityGrid() = default;
+
+  /** Rebuild the grid.
+   * \param entries The object spheres, the list is consumed.
+   * \param cellSize The size of a cell, usually the largest query radius.
+   */
+  void Build(std::vector<Entry> &entries, float cellSize);
+  void Clear();
+
+  /// Append the entries whose sphere could intersect the query sphere, read-only.
+  void Query(const MT_Vector3 &center, float radius, std::vector<const Entry *> &result) const;
+};
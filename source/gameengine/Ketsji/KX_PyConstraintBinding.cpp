@@ -40,6 +40,7 @@
 #include "PHY_IPhysicsEnvironment.h"
 
 #ifdef WITH_BULLET
+#  include "CcdShapeCache.h"
 #  include "LinearMath/btIDebugDraw.h"
 #endif
 
@@ -126,6 +127,18 @@ PyDoc_STRVAR(gPyRemoveConstraint__doc__,
 PyDoc_STRVAR(gPyGetAppliedImpulse__doc__,
              "getAppliedImpulse(int constraintId)\n"
              "");
+PyDoc_STRVAR(gPySetShapeCacheDirectory__doc__,
+             "setShapeCacheDirectory(string path)\n"
+             "Set the directory of the cooked triangle mesh shapes, empty to disable");
+PyDoc_STRVAR(gPyGetShapeCacheDirectory__doc__,
+             "getShapeCacheDirectory()\n"
+             "");
+PyDoc_STRVAR(gPySaveState__doc__,
+             "saveState()\n"
+             "Return the simulation state as bytes");
+PyDoc_STRVAR(gPyRestoreState__doc__,
+             "restoreState(bytes state)\n"
+             "Restore a simulation state returned by saveState");
 
 static PyObject *gPySetGravity(PyObject *self, PyObject *args, PyObject *kwds)
 {
@@ -596,6 +609,58 @@ static PyObject *gPyExportBulletFile(PyObject *, PyObject *args)
   Py_RETURN_NONE;
 }
 
+static PyObject *gPySetShapeCacheDirectory(PyObject *, PyObject *args)
+{
+  char *path;
+  if (!PyArg_ParseTuple(args, "s:setShapeCacheDirectory", &path))
+    return nullptr;
+
+#  ifdef WITH_BULLET
+  CcdShapeCache::SetDirectory(path);
+#  endif
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetShapeCacheDirectory(PyObject *)
+{
+#  ifdef WITH_BULLET
+  return PyUnicode_FromStdString(CcdShapeCache::GetDirectory());
+#  else
+  return PyUnicode_FromString("");
+#  endif
+}
+
+static PyObject *gPySaveState(PyObject *)
+{
+  std::vector<unsigned char> buffer;
+  if (!PHY_GetActiveEnvironment() || !PHY_GetActiveEnvironment()->SaveState(buffer)) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "saveState(): the physics environment doesn't support states");
+    return nullptr;
+  }
+
+  return PyBytes_FromStringAndSize((const char *)buffer.data(), buffer.size());
+}
+
+static PyObject *gPyRestoreState(PyObject *, PyObject *args)
+{
+  Py_buffer state;
+  if (!PyArg_ParseTuple(args, "y*:restoreState", &state))
+    return nullptr;
+
+  const unsigned char *data = (const unsigned char *)state.buf;
+  const std::vector<unsigned char> buffer(data, data + state.len);
+  PyBuffer_Release(&state);
+
+  if (!PHY_GetActiveEnvironment() || !PHY_GetActiveEnvironment()->RestoreState(buffer)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "restoreState(state): state doesn't match the current physics objects");
+    return nullptr;
+  }
+
+  Py_RETURN_NONE;
+}
+
 static struct PyMethodDef physicsconstraints_methods[] = {
     {"setGravity", (PyCFunction)gPySetGravity, METH_VARARGS, (const char *)gPySetGravity__doc__},
     {"setDebugMode",
@@ -693,6 +758,20 @@ static struct PyMethodDef physicsconstraints_methods[] = {
 
     {"exportBulletFile", (PyCFunction)gPyExportBulletFile, METH_VARARGS, "export a .bullet file"},
 
+    {"setShapeCacheDirectory",
+     (PyCFunction)gPySetShapeCacheDirectory,
+     METH_VARARGS,
+     (const char *)gPySetShapeCacheDirectory__doc__},
+    {"getShapeCacheDirectory",
+     (PyCFunction)gPyGetShapeCacheDirectory,
+     METH_NOARGS,
+     (const char *)gPyGetShapeCacheDirectory__doc__},
+    {"saveState", (PyCFunction)gPySaveState, METH_NOARGS, (const char *)gPySaveState__doc__},
+    {"restoreState",
+     (PyCFunction)gPyRestoreState,
+     METH_VARARGS,
+     (const char *)gPyRestoreState__doc__},
+
     // sentinel
     {nullptr, (PyCFunction) nullptr, 0, nullptr}};
 
@@ -30,14 +30,32 @@
 #  include "CM_Message.h"
 #  include "KX_GameObject.h"
 
+/// Call a python object using the fastest calling convention available.
+static PyObject *component_call(PyObject *callable, PyObject *const *args, size_t nargs)
+{
+#  if PY_VERSION_HEX >= 0x03090000
+  return PyObject_Vectorcall(callable, args, nargs, nullptr);
+#  elif PY_VERSION_HEX >= 0x03080000
+  return _PyObject_Vectorcall(callable, args, nargs, nullptr);
+#  else
+  return _PyObject_FastCall(callable, (PyObject **)args, nargs);
+#  endif
+}
+
 KX_PythonComponent::KX_PythonComponent(const std::string &name)
-    : m_pc(nullptr), m_gameobj(nullptr), m_name(name), m_init(false)
+    : m_pc(nullptr),
+      m_gameobj(nullptr),
+      m_name(name),
+      m_init(false),
+      m_update(nullptr),
+      m_batched(false)
 {
 }
 
 KX_PythonComponent::~KX_PythonComponent()
 {
   Dispose();
+  Py_XDECREF(m_update);
 }
 
 std::string KX_PythonComponent::GetName()
@@ -66,6 +84,8 @@ void KX_PythonComponent::ProcessReplica()
   CValue::ProcessReplica();
   m_gameobj = nullptr;
   m_init = false;
+  m_update = nullptr;
+  m_batched = false;
 }
 
 KX_GameObject *KX_PythonComponent::GetGameObject() const
@@ -97,17 +117,69 @@ void KX_PythonComponent::Start()
   Py_XDECREF(ret);
 }
 
-void KX_PythonComponent::Update()
+void KX_PythonComponent::InitUpdate()
+{
+  PyObject *pycomp = GetProxy();
+  PyTypeObject *type = Py_TYPE(pycomp);
+  PyObject *update_str = PyUnicode_FromString("update");
+  PyObject *update_batch_str = PyUnicode_FromString("update_batch");
+
+  m_batched = (_PyType_Lookup(type, update_batch_str) != nullptr);
+
+  Py_CLEAR(m_update);
+  /* Components updated by their class or not overriding the base update
+   * are never called individually. */
+  if (!m_batched && _PyType_Lookup(type, update_str) != _PyType_Lookup(&Type, update_str)) {
+    m_update = PyObject_GetAttr(pycomp, update_str);
+    if (!m_update) {
+      PyErr_Print();
+    }
+  }
+
+  Py_DECREF(update_str);
+  Py_DECREF(update_batch_str);
+  Py_DECREF(pycomp);
+}
+
+bool KX_PythonComponent::Prepare()
 {
   if (!m_init) {
     Start();
+    InitUpdate();
     m_init = true;
   }
 
-  PyObject *pycomp = GetProxy();
-  if (!PyObject_CallMethod(pycomp, "update", "")) {
+  return m_batched;
+}
+
+void KX_PythonComponent::Update()
+{
+  if (Prepare() || !m_update) {
+    return;
+  }
+
+  PyObject *ret = component_call(m_update, nullptr, 0);
+  if (!ret) {
     PyErr_Print();
   }
+  Py_XDECREF(ret);
+}
+
+void KX_PythonComponent::UpdateBatch(PyTypeObject *type, PyObject *components)
+{
+  PyObject *method = PyObject_GetAttrString((PyObject *)type, "update_batch");
+  if (!method) {
+    PyErr_Print();
+    return;
+  }
+
+  PyObject *ret = component_call(method, &components, 1);
+  if (!ret) {
+    PyErr_Print();
+  }
+
+  Py_XDECREF(ret);
+  Py_DECREF(method);
 }
 
 void KX_PythonComponent::Dispose()
@@ -179,6 +251,7 @@ PyTypeObject KX_PythonComponent::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "KX_P
                                          py_component_new};
 
 PyMethodDef KX_PythonComponent::Methods[] = {
+    KX_PYMETHODTABLE_NOARGS(KX_PythonComponent, update),
     {nullptr, nullptr}  // Sentinel
 };
 
@@ -187,6 +260,14 @@ PyAttributeDef KX_PythonComponent::Attributes[] = {
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
+KX_PYMETHODDEF_DOC_NOARGS(KX_PythonComponent,
+                          update,
+                          "update()\n"
+                          "Process the logic of the component, does nothing by default.\n")
+{
+  Py_RETURN_NONE;
+}
+
 PyObject *KX_PythonComponent::pyattr_get_object(PyObjectPlus *self_v,
                                                 const KX_PYATTRIBUTE_DEF *attrdef)
 {
@@ -37,6 +37,12 @@ class KX_PythonComponent : public CValue {
   KX_GameObject *m_gameobj;
   std::string m_name;
   bool m_init;
+  /// Cached bound update method, nullptr when the class doesn't override update.
+  PyObject *m_update;
+  /// True when the class implements the update_batch class method.
+  bool m_batched;
+
+  void InitUpdate();
 
  public:
   KX_PythonComponent(const std::string &name);
@@ -54,11 +60,20 @@ class KX_PythonComponent : public CValue {
   void SetBlenderPythonComponent(PythonComponent *pc);
 
   void Start();
+  /** Call start if needed and return true if the component must be updated
+   * by its class update_batch instead of its own update method.
+   */
+  bool Prepare();
   void Update();
   void Dispose();
 
+  /// Call update_batch on the class type with a list of its component proxies.
+  static void UpdateBatch(PyTypeObject *type, PyObject *components);
+
   static PyObject *py_component_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
 
+  KX_PYMETHOD_DOC_NOARGS(KX_PythonComponent, update);
+
   // Attributes
   static PyObject *pyattr_get_object(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
 };
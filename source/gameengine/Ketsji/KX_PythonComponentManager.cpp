@@ -26,12 +26,59 @@ void KX_PythonComponentManager::UnregisterObject(KX_GameObject *gameobj)
 
 void KX_PythonComponentManager::UpdateComponents()
 {
+#ifdef WITH_PYTHON
 	/* Update object components, we copy the object pointer in a second list to make
 	 * sure that we iterate on a list which will not be modified, indeed components
 	 * can add objects in theirs update.
 	 */
 	const std::vector<KX_GameObject *> objects = m_objects;
+
+	/* Components of classes implementing update_batch are gathered per class in
+	 * order of appearance and updated in one call after the individual updates.
+	 * The python lists hold a reference to the proxies in case a component is
+	 * freed meanwhile. */
+	std::vector<std::pair<PyTypeObject *, PyObject *>> batches;
+
 	for (KX_GameObject *gameobj : objects) {
-		gameobj->UpdateComponents();
+		CListValue<KX_PythonComponent> *components = gameobj->GetComponents();
+		if (!components) {
+			continue;
+		}
+
+		for (KX_PythonComponent *component : components) {
+			if (!component->Prepare()) {
+				component->Update();
+				continue;
+			}
+
+			PyObject *proxy = component->GetProxy();
+			PyTypeObject *type = Py_TYPE(proxy);
+			std::vector<std::pair<PyTypeObject *, PyObject *>>::iterator it = std::find_if(
+					batches.begin(), batches.end(), [type](const std::pair<PyTypeObject *, PyObject *> &batch) {
+						return batch.first == type;
+					});
+
+			if (it == batches.end()) {
+				PyObject *list = PyList_New(0);
+				if (!list) {
+					PyErr_Print();
+					Py_DECREF(proxy);
+					continue;
+				}
+				batches.emplace_back(type, list);
+				it = batches.end() - 1;
+			}
+
+			if (PyList_Append(it->second, proxy) == -1) {
+				PyErr_Print();
+			}
+			Py_DECREF(proxy);
+		}
+	}
+
+	for (const std::pair<PyTypeObject *, PyObject *> &batch : batches) {
+		KX_PythonComponent::UpdateBatch(batch.first, batch.second);
+		Py_DECREF(batch.second);
 	}
+#endif  // WITH_PYTHON
 }
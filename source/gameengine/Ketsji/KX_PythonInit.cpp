@@ -57,6 +57,7 @@
 #  include "DNA_scene_types.h"
 #  include "GPU_material.h"
 #  include "MEM_guardedalloc.h"
+#  include "PIL_time.h"
 #  include "bgl.h"
 #  include "blf_py_api.h"
 #  include "bl_math_py_api.h"
@@ -100,6 +101,7 @@
 #include "BL_Action.h"
 #include "BL_ActionActuator.h"
 #include "BL_BlenderConverter.h"
+#include "BL_BlenderScalarInterpolator.h"
 #include "BL_Shader.h"
 #include "CM_Message.h"
 #include "KX_Globals.h"
@@ -110,6 +112,7 @@
 #include "KX_PyConstraintBinding.h"
 #include "KX_PyMath.h"
 #include "KX_PythonInitTypes.h"
+#include "KX_SoundManager.h"
 #include "PHY_IPhysicsEnvironment.h"
 #include "RAS_2DFilterManager.h"
 #include "RAS_BucketManager.h"
@@ -340,6 +343,21 @@ static PyObject *gPyGetLogicTicRate(PyObject *)
   return PyFloat_FromDouble(KX_GetActiveEngine()->GetTicRate());
 }
 
+static PyObject *gPySetActionSampleTolerance(PyObject *, PyObject *args)
+{
+  float tolerance;
+  if (!PyArg_ParseTuple(args, "f:setActionSampleTolerance", &tolerance))
+    return nullptr;
+
+  BL_InterpolatorList::SetSampleTolerance(tolerance);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetActionSampleTolerance(PyObject *)
+{
+  return PyFloat_FromDouble(BL_InterpolatorList::GetSampleTolerance());
+}
+
 static PyObject *gPySetExitKey(PyObject *, PyObject *args)
 {
   short exitkey;
@@ -383,6 +401,21 @@ static PyObject *gPyGetMaxLogicFrame(PyObject *)
   return PyLong_FromLong(KX_GetActiveEngine()->GetMaxLogicFrame());
 }
 
+static PyObject *gPySetLibLoadMergeBudget(PyObject *, PyObject *args)
+{
+  float budget;
+  if (!PyArg_ParseTuple(args, "f:setLibLoadMergeBudget", &budget))
+    return nullptr;
+
+  KX_GetActiveEngine()->GetConverter()->SetMergeBudget(std::max(budget, 0.0f));
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetLibLoadMergeBudget(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetConverter()->GetMergeBudget());
+}
+
 static PyObject *gPySetMaxPhysicsFrame(PyObject *, PyObject *args)
 {
   int frame;
@@ -445,6 +478,61 @@ static PyObject *gPySetUseExternalClock(PyObject *, PyObject *args)
   Py_RETURN_NONE;
 }
 
+static PyObject *gPyGetUsePhysicsInterpolation(PyObject *)
+{
+  return PyBool_FromLong(KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::PHYSICS_INTERPOLATION));
+}
+
+static PyObject *gPySetUsePhysicsInterpolation(PyObject *, PyObject *args)
+{
+  int interpolate;
+
+  if (!PyArg_ParseTuple(args, "p:setUsePhysicsInterpolation", &interpolate))
+    return nullptr;
+
+  KX_GetActiveEngine()->SetFlag(KX_KetsjiEngine::PHYSICS_INTERPOLATION, (bool)interpolate);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetMaxSoundVoices(PyObject *)
+{
+  return PyLong_FromLong(KX_GetActiveEngine()->GetSoundManager()->GetMaxVoices());
+}
+
+static PyObject *gPySetMaxSoundVoices(PyObject *, PyObject *args)
+{
+  int voices;
+
+  if (!PyArg_ParseTuple(args, "i:setMaxSoundVoices", &voices))
+    return nullptr;
+
+  if (voices < 0) {
+    PyErr_SetString(PyExc_ValueError,
+                    "bge.logic.setMaxSoundVoices(voices): expected a positive value or 0");
+    return nullptr;
+  }
+
+  KX_GetActiveEngine()->GetSoundManager()->SetMaxVoices(voices);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetInputEvents(PyObject *)
+{
+  KX_KetsjiEngine *engine = KX_GetActiveEngine();
+  const std::vector<SCA_IInputDevice::EventRecord> &events = engine->GetInputDevice()->GetEvents();
+  // The events are dated with the system timer, return them in the time of getRealTime.
+  const double offset = engine->GetRealTime() - PIL_check_seconds_timer();
+
+  PyObject *list = PyList_New(events.size());
+  for (unsigned int i = 0, size = events.size(); i < size; ++i) {
+    const SCA_IInputDevice::EventRecord &event = events[i];
+    PyList_SET_ITEM(
+        list, i, Py_BuildValue("(iid)", event.m_type, event.m_value, event.m_time + offset));
+  }
+
+  return list;
+}
+
 static PyObject *gPyGetClockTime(PyObject *)
 {
   return PyFloat_FromDouble(KX_GetActiveEngine()->GetClockTime());
@@ -597,7 +685,7 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
   KX_LibLoadStatus *status = nullptr;
 
   short options = 0;
-  int load_actions = 0, verbose = 0, load_scripts = 1, asynchronous = 0;
+  int load_actions = 0, verbose = 0, load_scripts = 1, asynchronous = 0, priority = 0;
 
   static const char *kwlist[] = {"path",
                                  "group",
@@ -607,11 +695,12 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
                                  "load_scripts",
                                  "asynchronous",
                                  "scene",
+                                 "priority",
                                  nullptr};
 
   if (!PyArg_ParseTupleAndKeywords(args,
                                    kwds,
-                                   "ss|y*iiIiO:LibLoad",
+                                   "ss|y*iiIiOi:LibLoad",
                                    const_cast<char **>(kwlist),
                                    &path,
                                    &group,
@@ -620,7 +709,8 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
                                    &verbose,
                                    &load_scripts,
                                    &asynchronous,
-                                   &pyscene))
+                                   &pyscene,
+                                   &priority))
     return nullptr;
 
   if (!ConvertPythonToScene(pyscene, &kx_scene, true, "invalid scene")) {
@@ -648,14 +738,15 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
     BLI_strncpy(abs_path, path, sizeof(abs_path));
     BLI_path_abs(abs_path, KX_GetMainPath().c_str());
 
-    if ((status = converter->LinkBlendFilePath(abs_path, group, kx_scene, &err_str, options))) {
+    if ((status = converter->LinkBlendFilePath(
+             abs_path, group, kx_scene, &err_str, options, priority))) {
       return status->GetProxy();
     }
   }
   else {
 
     if ((status = converter->LinkBlendFileMemory(
-             py_buffer.buf, py_buffer.len, path, group, kx_scene, &err_str, options))) {
+             py_buffer.buf, py_buffer.len, path, group, kx_scene, &err_str, options, priority))) {
       PyBuffer_Release(&py_buffer);
       return status->GetProxy();
     }
@@ -811,6 +902,14 @@ static struct PyMethodDef game_methods[] = {
      (PyCFunction)gPySetMaxLogicFrame,
      METH_VARARGS,
      (const char *)"Sets the max number of logic frame per render frame"},
+    {"getLibLoadMergeBudget",
+     (PyCFunction)gPyGetLibLoadMergeBudget,
+     METH_NOARGS,
+     (const char *)"Gets the max time spent merging asynchronous libloads per frame"},
+    {"setLibLoadMergeBudget",
+     (PyCFunction)gPySetLibLoadMergeBudget,
+     METH_VARARGS,
+     (const char *)"Sets the max time spent merging asynchronous libloads per frame"},
     {"getMaxPhysicsFrame",
      (PyCFunction)gPyGetMaxPhysicsFrame,
      METH_NOARGS,
@@ -835,6 +934,14 @@ static struct PyMethodDef game_methods[] = {
      (PyCFunction)gPySetPhysicsTicRate,
      METH_VARARGS,
      (const char *)"Sets the physics tic rate"},
+    {"getActionSampleTolerance",
+     (PyCFunction)gPyGetActionSampleTolerance,
+     METH_NOARGS,
+     (const char *)"Gets the tolerance used to sample the action F-curves"},
+    {"setActionSampleTolerance",
+     (PyCFunction)gPySetActionSampleTolerance,
+     METH_VARARGS,
+     (const char *)"Sets the tolerance used to sample the action F-curves"},
     {"getExitKey",
      (PyCFunction)gPyGetExitKey,
      METH_NOARGS,
@@ -859,6 +966,27 @@ static struct PyMethodDef game_methods[] = {
      (PyCFunction)gPySetUseExternalClock,
      METH_VARARGS,
      (const char *)"Set if we use the time provided by an external clock"},
+    {"getUsePhysicsInterpolation",
+     (PyCFunction)gPyGetUsePhysicsInterpolation,
+     METH_NOARGS,
+     (const char *)"Get if the physics objects are interpolated between logic frames"},
+    {"setUsePhysicsInterpolation",
+     (PyCFunction)gPySetUsePhysicsInterpolation,
+     METH_VARARGS,
+     (const char *)"Set if the physics objects are interpolated between logic frames"},
+    {"getMaxSoundVoices",
+     (PyCFunction)gPyGetMaxSoundVoices,
+     METH_NOARGS,
+     (const char *)"Get the maximum number of playing 3D sounds, 0 for no limit"},
+    {"setMaxSoundVoices",
+     (PyCFunction)gPySetMaxSoundVoices,
+     METH_VARARGS,
+     (const char *)"Set the maximum number of playing 3D sounds, 0 for no limit"},
+    {"getInputEvents",
+     (PyCFunction)gPyGetInputEvents,
+     METH_NOARGS,
+     (const char *)"Get all the keyboard and mouse events of the logic frame in arrival order, "
+                   "as (type, value, time) tuples"},
     {"getClockTime",
      (PyCFunction)gPyGetClockTime,
      METH_NOARGS,
@@ -36,6 +36,8 @@
 
 #include "KX_Scene.h"
 
+#include <cmath>
+
 #include "BKE_lib_id.h"
 #include "BKE_object.h"
 #include "BKE_screen.h"
@@ -54,6 +56,7 @@
 #include "BL_BlenderConverter.h"
 #include "BL_BlenderDataConversion.h"
 #include "BL_BlenderSceneConverter.h"
+#include "BL_PoseCache.h"
 #include "EXP_FloatValue.h"
 #include "KX_2DFilterManager.h"
 #include "KX_BlenderCanvas.h"
@@ -62,6 +65,7 @@
 #include "KX_FontObject.h"
 #include "KX_Globals.h"
 #include "KX_Light.h"
+#include "KX_LodLevel.h"
 #include "KX_LodManager.h"
 #include "KX_MotionState.h"
 #include "KX_NetworkMessageScene.h"
@@ -69,8 +73,10 @@
 #include "KX_PhysicsEngineEnums.h"
 #include "KX_PyMath.h"
 #include "KX_SG_NodeRelationships.h"
+#include "KX_SceneSnapshot.h"
 #include "PHY_IPhysicsController.h"
 #include "PHY_IPhysicsEnvironment.h"
+#include "PIL_time.h"
 #include "RAS_BucketManager.h"
 #include "RAS_FrameBuffer.h"
 #include "SCA_2DFilterActuator.h"
@@ -129,6 +135,7 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
                    KX_NetworkMessageManager *messageManager)
     : CValue(),
       m_resetTaaSamples(false),               // eevee
+      m_objectsTagged(false),                 // eevee
       m_lastReplicatedParentObject(nullptr),  // eevee
       m_gameDefaultCamera(nullptr),           // eevee
       m_shadingTypeBackup(0),                 // eevee
@@ -185,6 +192,8 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
   m_rootnode = nullptr;
 
   m_bucketmanager = new RAS_BucketManager();
+  m_poseCache = new BL_PoseCache();
+  m_snapshot = nullptr;
 
   bool showObstacleSimulation = (scene->gm.flag & GAME_SHOW_OBSTACLE_SIMULATION) != 0;
   switch (scene->gm.obstacleSimulation) {
@@ -378,6 +387,12 @@ KX_Scene::~KX_Scene()
   if (m_bucketmanager) {
     delete m_bucketmanager;
   }
+  if (m_poseCache) {
+    delete m_poseCache;
+  }
+  if (m_snapshot) {
+    delete m_snapshot;
+  }
   if (m_sceneConverter) {
     delete m_sceneConverter;
   }
@@ -647,16 +662,27 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, const RAS_Rect &viewport,
     m_collectionRemap = false;
   }
 
+  // Evaluate the objects tagged by the previous camera, nothing is done if none are tagged.
   BKE_scene_graph_update_tagged(depsgraph, bmain);
 
-  for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForUpdate(is_overlay_pass);
+  /* The objects transforms don't depend on the camera, they are tagged only once per frame
+   * for all the viewports and the overlay pass, which then share the TAA samples reset. The
+   * drawing callbacks clear the tag as they can move objects. */
+  if (!m_objectsTagged) {
+    for (KX_GameObject *gameobj : GetObjectList()) {
+      // The transform is saved, a new tag in this frame only updates the objects moved since.
+      gameobj->TagForUpdate(true);
+    }
+    // The render in the constructor is not part of a frame.
+    m_objectsTagged = (cam != nullptr);
   }
 
   engine->EndCountDepsgraphTime();
 
-  bool reset_taa_samples = m_resetTaaSamples;
-  m_resetTaaSamples = false;
+  const bool reset_taa_samples = m_resetTaaSamples;
+  if (!cam) {
+    m_resetTaaSamples = false;
+  }
 
   rcti window;
   int v[4];
@@ -803,6 +829,12 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, const RAS_Rect &viewport,
   GPU_blend(GPU_BLEND_NONE);
 }
 
+void KX_Scene::EndRender()
+{
+  m_objectsTagged = false;
+  m_resetTaaSamples = false;
+}
+
 void KX_Scene::RenderAfterCameraSetupImageRender(KX_Camera *cam,
                                                  RAS_Rasterizer *rasty,
                                                  const rcti *window)
@@ -1113,7 +1145,10 @@ std::string KX_Scene::GetName()
 /// Set the name of the value
 void KX_Scene::SetName(const std::string &name)
 {
-  m_sceneName = name;
+  if (name != m_sceneName) {
+    m_sceneName = name;
+    NameChanged();
+  }
 }
 
 RAS_BucketManager *KX_Scene::GetBucketManager() const
@@ -1121,6 +1156,11 @@ RAS_BucketManager *KX_Scene::GetBucketManager() const
   return m_bucketmanager;
 }
 
+BL_PoseCache *KX_Scene::GetPoseCache() const
+{
+  return m_poseCache;
+}
+
 CListValue<KX_GameObject> *KX_Scene::GetObjectList() const
 {
   return m_objectlist;
@@ -2096,6 +2136,9 @@ void KX_Scene::UpdateAnimations(double curtime)
 {
   // m_animationPoolData.curtime = curtime;
 
+  // The poses of the previous frame can't be shared anymore.
+  m_poseCache->Clear();
+
   for (KX_GameObject *gameobj : m_animatedlist) {
     // BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false,
     // TASK_PRIORITY_LOW);
@@ -2155,6 +2198,16 @@ void KX_Scene::UpdateParents(double curtime)
   }
 }
 
+void KX_Scene::UpdatePhysicsInterpolation(double curtime, double framestep)
+{
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    PHY_IPhysicsController *ctrl = gameobj->GetPhysicsController();
+    if (ctrl && ctrl->IsDynamic() && !ctrl->IsDynamicsSuspended()) {
+      gameobj->UpdatePhysicsInterpolation(curtime, framestep);
+    }
+  }
+}
+
 RAS_MaterialBucket *KX_Scene::FindBucket(class RAS_IPolyMaterial *polymat, bool &bucketCreated)
 {
   return m_bucketmanager->FindBucket(polymat, bucketCreated);
@@ -2162,11 +2215,92 @@ RAS_MaterialBucket *KX_Scene::FindBucket(class RAS_IPolyMaterial *polymat, bool
 
 void KX_Scene::UpdateObjectLods(KX_Camera *cam /*, const KX_CullingNodeList& nodes*/)
 {
+  LodBatch &batch = m_lodBatch;
+  batch.m_objects.clear();
+  batch.m_replacedObjects.clear();
+
+  /* Only the objects with several lod levels select a level, the objects with a single level
+   * from ReplaceMesh only render the data of another object. */
+  for (KX_GameObject *gameobj : m_kxobWithLod) {
+    KX_LodManager *lodManager = gameobj->GetLodManager();
+    if (!lodManager) {
+      continue;
+    }
+    if (lodManager->GetLevelCount() > 1) {
+      batch.m_objects.push_back(gameobj);
+    }
+    else if (lodManager->GetLevel(0)->GetObject() != gameobj->GetBlenderObject()) {
+      batch.m_replacedObjects.push_back(gameobj);
+    }
+  }
+
+  const unsigned int count = batch.m_objects.size();
+  if (count == 0 && batch.m_replacedObjects.empty()) {
+    return;
+  }
+
   const MT_Vector3 &cam_pos = cam->NodeGetWorldPosition();
   const float lodfactor = cam->GetLodDistanceFactor();
 
-  for (KX_GameObject *gameobj : m_kxobWithLod) {
-    gameobj->UpdateLod(cam_pos, 1.0f /*lodfactor*/);
+  batch.m_positionsX.resize(count);
+  batch.m_positionsY.resize(count);
+  batch.m_positionsZ.resize(count);
+  batch.m_factors2.resize(count);
+  batch.m_upDistances2.resize(count);
+  batch.m_downDistances2.resize(count);
+  batch.m_distances2.resize(count);
+
+  // Gather the object data in contiguous arrays.
+  for (unsigned int i = 0; i < count; ++i) {
+    KX_GameObject *gameobj = batch.m_objects[i];
+    KX_LodManager *lodManager = gameobj->GetLodManager();
+    const MT_Vector3 &pos = gameobj->NodeGetWorldPosition();
+    batch.m_positionsX[i] = pos.x();
+    batch.m_positionsY[i] = pos.y();
+    batch.m_positionsZ[i] = pos.z();
+
+    const float factor = lodfactor * lodManager->GetDistanceFactor();
+    batch.m_factors2[i] = factor * factor;
+    lodManager->GetLevelDistances(
+        this, gameobj->GetLodLevel(), batch.m_upDistances2[i], batch.m_downDistances2[i]);
+  }
+
+  // Compute the distances without branches, the compiler can vectorize this loop.
+  const float camx = cam_pos.x();
+  const float camy = cam_pos.y();
+  const float camz = cam_pos.z();
+  const float *__restrict posx = batch.m_positionsX.data();
+  const float *__restrict posy = batch.m_positionsY.data();
+  const float *__restrict posz = batch.m_positionsZ.data();
+  const float *__restrict factors2 = batch.m_factors2.data();
+  float *__restrict distances2 = batch.m_distances2.data();
+  for (unsigned int i = 0; i < count; ++i) {
+    const float dx = posx[i] - camx;
+    const float dy = posy[i] - camy;
+    const float dz = posz[i] - camz;
+    distances2[i] = (dx * dx + dy * dy + dz * dz) * factors2[i];
+  }
+
+  bContext *C = KX_GetActiveEngine()->GetContext();
+  Depsgraph *depsgraph = CTX_data_expect_evaluated_depsgraph(C);
+
+  // Only the objects leaving the range of their current level search a new level.
+  for (unsigned int i = 0; i < count; ++i) {
+    KX_GameObject *gameobj = batch.m_objects[i];
+    const float distance2 = distances2[i];
+    if (distance2 >= batch.m_upDistances2[i] || distance2 < batch.m_downDistances2[i]) {
+      const unsigned short level = gameobj->GetLodManager()->GetLevelIndex(
+          this, gameobj->GetLodLevel(), distance2);
+      if (level != gameobj->GetLodLevel()) {
+        gameobj->SetLodLevel(level);
+      }
+    }
+
+    gameobj->UpdateLodObject(depsgraph);
+  }
+
+  for (KX_GameObject *gameobj : batch.m_replacedObjects) {
+    gameobj->UpdateLodObject(depsgraph);
   }
 }
 
@@ -2284,21 +2418,6 @@ static void MergeScene_LogicBrick(SCA_ILogicBrick *brick, KX_Scene *from, KX_Sce
 
 static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene *from)
 {
-  SCA_ActuatorList& actuators = gameobj->GetActuators();
-  for (SCA_IActuator *actuator : actuators) {
-    MergeScene_LogicBrick(actuator, from, to);
-  }
-
-  SCA_SensorList& sensors = gameobj->GetSensors();
-  for (SCA_ISensor *sensor : sensors) {
-    MergeScene_LogicBrick(sensor, from, to);
-  }
-
-  SCA_ControllerList& controllers = gameobj->GetControllers();
-  for (SCA_IController *controller : controllers) {
-    MergeScene_LogicBrick(controller, from, to);
-  }
-
   /* graphics controller */
   PHY_IController *ctrl = gameobj->GetPhysicsController();
   if (ctrl) {
@@ -2319,10 +2438,6 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
     }
   }
 
-  // All armatures should be in the animated object list to be umpdated.
-  if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE)
-    to->AddAnimatedObject(gameobj);
-
   /* Add the object to the scene's logic manager */
   to->GetLogicManager()->RegisterGameObjectName(gameobj->GetName(), gameobj);
   to->GetLogicManager()->RegisterGameObj(gameobj->GetBlenderObject(), gameobj);
@@ -2335,34 +2450,117 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
   }
 }
 
+/// Move the logic bricks and animations of an object, this activates them in the scene.
+static void MergeScene_GameObjectLogic(KX_GameObject *gameobj, KX_Scene *to, KX_Scene *from)
+{
+  SCA_ActuatorList& actuators = gameobj->GetActuators();
+  for (SCA_IActuator *actuator : actuators) {
+    MergeScene_LogicBrick(actuator, from, to);
+  }
+
+  SCA_SensorList& sensors = gameobj->GetSensors();
+  for (SCA_ISensor *sensor : sensors) {
+    MergeScene_LogicBrick(sensor, from, to);
+  }
+
+  SCA_ControllerList& controllers = gameobj->GetControllers();
+  for (SCA_IController *controller : controllers) {
+    MergeScene_LogicBrick(controller, from, to);
+  }
+
+  // All armatures should be in the animated object list to be umpdated.
+  if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE)
+    to->AddAnimatedObject(gameobj);
+}
+
+KX_SceneMergeState::KX_SceneMergeState(KX_Scene *other)
+    : m_other(other), m_stage(MERGE_BEGIN), m_index(0), m_success(true)
+{
+}
+
 bool KX_Scene::MergeScene(KX_Scene *other)
 {
+  KX_SceneMergeState state(other);
+  MergeSceneStep(state, 0.0);
+  return state.m_success;
+}
+
+bool KX_Scene::MergeSceneStep(KX_SceneMergeState &state, double deadline)
+{
+  if (state.m_stage == KX_SceneMergeState::MERGE_DONE) {
+    return true;
+  }
+
+  KX_Scene *other = state.m_other;
   PHY_IPhysicsEnvironment *env = this->GetPhysicsEnvironment();
   PHY_IPhysicsEnvironment *env_other = other->GetPhysicsEnvironment();
 
-  if ((env == nullptr) !=
-      (env_other == nullptr)) /* TODO - even when both scenes have NONE physics, the other is
-                                 loaded with bullet enabled, ??? */
-  {
-    CM_FunctionError("physics scenes type differ, aborting\n\tsource "
-                     << (int)(env != nullptr) << ", target " << (int)(env_other != nullptr));
-    return false;
-  }
+  if (state.m_stage == KX_SceneMergeState::MERGE_BEGIN) {
+    if ((env == nullptr) !=
+        (env_other == nullptr)) /* TODO - even when both scenes have NONE physics, the other is
+                                   loaded with bullet enabled, ??? */
+    {
+      CM_FunctionError("physics scenes type differ, aborting\n\tsource "
+                       << (int)(env != nullptr) << ", target " << (int)(env_other != nullptr));
+      state.m_success = false;
+      state.m_stage = KX_SceneMergeState::MERGE_DONE;
+      return true;
+    }
+
+    GetBucketManager()->MergeBucketManager(other->GetBucketManager());
 
-  GetBucketManager()->MergeBucketManager(other->GetBucketManager());
+    state.m_stage = KX_SceneMergeState::MERGE_OBJECTS;
+    state.m_index = 0;
+  }
 
   /* active + inactive == all ??? - lets hope so */
-  for (KX_GameObject *gameobj : *other->GetObjectList()) {
-    MergeScene_GameObject(gameobj, this, other);
+  if (state.m_stage == KX_SceneMergeState::MERGE_OBJECTS) {
+    CListValue<KX_GameObject> *objects = other->GetObjectList();
+    while (state.m_index < objects->GetCount()) {
+      KX_GameObject *gameobj = objects->GetValue(state.m_index++);
+      MergeScene_GameObject(gameobj, this, other);
+
+      // Freeze the object in the physics world until the whole scene is merged.
+      PHY_IPhysicsController *ctrl = gameobj->GetPhysicsController();
+      if (ctrl) {
+        ctrl->SetActive(false);
+      }
+
+      /* add properties to debug list for LibLoad objects */
+      if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
+        AddObjectDebugProperties(gameobj);
+      }
 
-    /* add properties to debug list for LibLoad objects */
-    if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
-      AddObjectDebugProperties(gameobj);
+      if (deadline > 0.0 && PIL_check_seconds_timer() > deadline) {
+        return false;
+      }
     }
+
+    state.m_stage = KX_SceneMergeState::MERGE_INACTIVE_OBJECTS;
+    state.m_index = 0;
+  }
+
+  if (state.m_stage == KX_SceneMergeState::MERGE_INACTIVE_OBJECTS) {
+    CListValue<KX_GameObject> *objects = other->GetInactiveList();
+    while (state.m_index < objects->GetCount()) {
+      MergeScene_GameObject(objects->GetValue(state.m_index++), this, other);
+
+      if (deadline > 0.0 && PIL_check_seconds_timer() > deadline) {
+        return false;
+      }
+    }
+
+    state.m_stage = KX_SceneMergeState::MERGE_FINISH;
+  }
+
+  /* The remaining steps activate the merged objects and are done at once, the objects never
+   * run logic or physics while the scene is partially merged. */
+  for (KX_GameObject *gameobj : *other->GetObjectList()) {
+    MergeScene_GameObjectLogic(gameobj, this, other);
   }
 
   for (KX_GameObject *gameobj : *other->GetInactiveList()) {
-    MergeScene_GameObject(gameobj, this, other);
+    MergeScene_GameObjectLogic(gameobj, this, other);
   }
 
   if (env) {
@@ -2379,8 +2577,10 @@ bool KX_Scene::MergeScene(KX_Scene *other)
 
     for (unsigned int i = 0; i < physicsObjects.size(); ++i) {
       KX_GameObject *gameobj = physicsObjects[i];
+      PHY_IPhysicsController *ctrl = gameobj->GetPhysicsController();
+      ctrl->SetActive(true);
       // Replicate all constraints in the right physics environment.
-      gameobj->GetPhysicsController()->ReplicateConstraints(gameobj, physicsObjects);
+      ctrl->ReplicateConstraints(gameobj, physicsObjects);
       gameobj->ClearConstraints();
     }
   }
@@ -2438,6 +2638,8 @@ bool KX_Scene::MergeScene(KX_Scene *other)
       timemgr->AddTimeProperty(times[i]);
     }
   }
+
+  state.m_stage = KX_SceneMergeState::MERGE_DONE;
   return true;
 }
 
@@ -2470,6 +2672,9 @@ void KX_Scene::RunDrawingCallbacks(DrawingCallbackType callbackType, KX_Camera *
   else {
     RunPythonCallBackList(list, nullptr, 0, 0);
   }
+
+  // The callbacks can move objects, the next camera must tag them again.
+  m_objectsTagged = false;
 }
 
 //----------------------------------------------------------------------------
@@ -2524,6 +2729,8 @@ PyMethodDef KX_Scene::Methods[] = {
     KX_PYMETHODTABLE(KX_Scene, convertBlenderCollection),
     KX_PYMETHODTABLE(KX_Scene, addOverlayCollection),
     KX_PYMETHODTABLE(KX_Scene, removeOverlayCollection),
+    KX_PYMETHODTABLE(KX_Scene, saveSnapshot),
+    KX_PYMETHODTABLE(KX_Scene, loadSnapshot),
 
     /* dict style access */
     KX_PYMETHODTABLE(KX_Scene, get),
@@ -2806,6 +3013,37 @@ int KX_Scene::pyattr_set_gravity(PyObjectPlus *self_v,
   return PY_SET_ATTR_SUCCESS;
 }
 
+PyObject *KX_Scene::pyattr_get_pose_cache_frame_step(PyObjectPlus *self_v,
+                                                     const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  return PyFloat_FromDouble(self->m_poseCache->GetFrameStep());
+}
+
+int KX_Scene::pyattr_set_pose_cache_frame_step(PyObjectPlus *self_v,
+                                               const KX_PYATTRIBUTE_DEF *attrdef,
+                                               PyObject *value)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  const float step = PyFloat_AsDouble(value);
+  if (step == -1.0f && PyErr_Occurred()) {
+    PyErr_SetString(PyExc_TypeError,
+                    "scene.poseCacheFrameStep = float: KX_Scene, expected a float");
+    return PY_SET_ATTR_FAIL;
+  }
+  if (!std::isfinite(step) || step < 0.0f) {
+    PyErr_SetString(
+        PyExc_ValueError,
+        "scene.poseCacheFrameStep = float: KX_Scene, expected a finite positive float");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->m_poseCache->SetFrameStep(step);
+  return PY_SET_ATTR_SUCCESS;
+}
+
 PyAttributeDef KX_Scene::Attributes[] = {
     KX_PYATTRIBUTE_RO_FUNCTION("name", KX_Scene, pyattr_get_name),
     KX_PYATTRIBUTE_RO_FUNCTION("objects", KX_Scene, pyattr_get_objects),
@@ -2827,6 +3065,10 @@ PyAttributeDef KX_Scene::Attributes[] = {
     KX_PYATTRIBUTE_RW_FUNCTION(
         "pre_draw_setup", KX_Scene, pyattr_get_drawing_callback, pyattr_set_drawing_callback),
     KX_PYATTRIBUTE_RW_FUNCTION("gravity", KX_Scene, pyattr_get_gravity, pyattr_set_gravity),
+    KX_PYATTRIBUTE_RW_FUNCTION("poseCacheFrameStep",
+                               KX_Scene,
+                               pyattr_get_pose_cache_frame_step,
+                               pyattr_set_pose_cache_frame_step),
     KX_PYATTRIBUTE_BOOL_RO("activity_culling", KX_Scene, m_activity_culling),
     KX_PYATTRIBUTE_FLOAT_RW(
         "activity_culling_radius", 0.5f, FLT_MAX, KX_Scene, m_activity_box_radius),
@@ -2926,6 +3168,59 @@ KX_PYMETHODDEF_DOC(KX_Scene,
   Py_RETURN_NONE;
 }
 
+KX_PYMETHODDEF_DOC(KX_Scene,
+                   saveSnapshot,
+                   "saveSnapshot(path, delta=False)\n"
+                   "Save the game state of the objects to a file.\n")
+{
+  const char *path;
+  int delta = 0;
+
+  if (!PyArg_ParseTuple(args, "s|p:saveSnapshot", &path, &delta)) {
+    return nullptr;
+  }
+
+  if (!m_snapshot) {
+    m_snapshot = new KX_SceneSnapshot();
+  }
+
+  // Serialize now and write the file in a worker thread.
+  std::vector<unsigned char> buffer;
+  m_snapshot->Save(this, delta, buffer);
+  m_snapshot->WriteFile(path, std::move(buffer));
+
+  Py_RETURN_NONE;
+}
+
+KX_PYMETHODDEF_DOC(KX_Scene,
+                   loadSnapshot,
+                   "loadSnapshot(path)\n"
+                   "Restore the game state of the objects from a file.\n")
+{
+  const char *path;
+
+  if (!PyArg_ParseTuple(args, "s:loadSnapshot", &path)) {
+    return nullptr;
+  }
+
+  if (!m_snapshot) {
+    m_snapshot = new KX_SceneSnapshot();
+  }
+
+  std::vector<unsigned char> buffer;
+  if (!m_snapshot->ReadFile(path, buffer)) {
+    PyErr_Format(PyExc_IOError, "scene.loadSnapshot(path): unable to read \"%s\"", path);
+    return nullptr;
+  }
+
+  if (!m_snapshot->Load(this, buffer)) {
+    PyErr_Format(PyExc_ValueError, "scene.loadSnapshot(path): invalid snapshot \"%s\"", path);
+    return nullptr;
+  }
+
+  Py_RETURN_NONE;
+}
+
 /* Matches python dict.get(key, [default]) */
 KX_PYMETHODDEF_DOC(KX_Scene, get, "")
 {
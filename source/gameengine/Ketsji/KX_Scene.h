@@ -73,6 +73,9 @@ class KX_GameObject;
 class KX_LightObject;
 class RAS_MeshObject;
 class RAS_BucketManager;
+class BL_PoseCache;
+class KX_Scene;
+class KX_SceneSnapshot;
 class RAS_MaterialBucket;
 class RAS_IPolyMaterial;
 class RAS_Rasterizer;
@@ -96,6 +99,21 @@ struct Object;
 /* for ID freeing */
 #define IS_TAGGED(_id) ((_id) && (((ID *)_id)->tag & LIB_TAG_DOIT))
 
+/// Progress of a scene merged in several steps, see KX_Scene::MergeSceneStep().
+struct KX_SceneMergeState {
+  enum Stage { MERGE_BEGIN = 0, MERGE_OBJECTS, MERGE_INACTIVE_OBJECTS, MERGE_FINISH, MERGE_DONE };
+
+  KX_SceneMergeState(KX_Scene *other);
+
+  /// The scene merged into the scene calling MergeSceneStep().
+  KX_Scene *m_other;
+  Stage m_stage;
+  /// Index of the next object to merge in the list of the current stage.
+  unsigned int m_index;
+  /// False if the scenes couldn't be merged.
+  bool m_success;
+};
+
 /**
  * The KX_Scene holds all data for an independent scene. It relates
  * KX_Objects to the specific objects in the modules.
@@ -119,6 +137,8 @@ class KX_Scene : public CValue, public SCA_IScene {
  protected:
   /***************EEVEE INTEGRATION*****************/
   bool m_resetTaaSamples;
+  /// The objects were already tagged for the depsgraph by a camera of the rendered frame.
+  bool m_objectsTagged;
   Object *m_lastReplicatedParentObject;
   Object *m_gameDefaultCamera;
   int m_shadingTypeBackup;
@@ -134,12 +154,37 @@ class KX_Scene : public CValue, public SCA_IScene {
   BL_BlenderSceneConverter *m_sceneConverter;
   bool m_isPythonMainLoop;
   std::vector<KX_GameObject *> m_kxobWithLod;
+  /** Structure of arrays of the objects with lod used by UpdateObjectLods, the arrays are
+   * kept between frames to avoid allocations.
+   */
+  struct LodBatch {
+    /// Objects with several lod levels.
+    std::vector<KX_GameObject *> m_objects;
+    /// Objects with a single level rendering the data of another object.
+    std::vector<KX_GameObject *> m_replacedObjects;
+    std::vector<float> m_positionsX;
+    std::vector<float> m_positionsY;
+    std::vector<float> m_positionsZ;
+    /// Squared product of the camera and lod manager distance factors.
+    std::vector<float> m_factors2;
+    /// Squared distance range in which the current level is kept.
+    std::vector<float> m_upDistances2;
+    std::vector<float> m_downDistances2;
+    /// Scaled squared distance to the camera.
+    std::vector<float> m_distances2;
+  } m_lodBatch;
   std::map<Object *, char> m_obRestrictFlags;
   bool m_collectionRemap;
   /*************************************************/
 
   RAS_BucketManager *m_bucketmanager;
 
+  /// Armature poses evaluated from actions during the current frame.
+  BL_PoseCache *m_poseCache;
+
+  /// Game state snapshots of the scene, created on first use.
+  KX_SceneSnapshot *m_snapshot;
+
   std::vector<KX_GameObject *> m_tempObjectList;
 
   /**
@@ -323,6 +368,8 @@ class KX_Scene : public CValue, public SCA_IScene {
   std::vector<Object *> m_hiddenObjectsDuringRuntime;
 
   void RenderAfterCameraSetup(KX_Camera *cam, const RAS_Rect &viewport, bool is_overlay_pass);
+  /// Reset the state shared by all the cameras rendered in a frame.
+  void EndRender();
   void RenderAfterCameraSetupImageRender(KX_Camera *cam,
                                          RAS_Rasterizer *rasty,
                                          const struct rcti *window);
@@ -353,6 +400,7 @@ class KX_Scene : public CValue, public SCA_IScene {
   /***************End of EEVEE INTEGRATION**********************/
 
   RAS_BucketManager *GetBucketManager() const;
+  BL_PoseCache *GetPoseCache() const;
   RAS_MaterialBucket *FindBucket(RAS_IPolyMaterial *polymat, bool &bucketCreated);
 
   /**
@@ -361,6 +409,8 @@ class KX_Scene : public CValue, public SCA_IScene {
   static bool KX_ScenegraphUpdateFunc(SG_Node *node, void *gameobj, void *scene);
   static bool KX_ScenegraphRescheduleFunc(SG_Node *node, void *gameobj, void *scene);
   void UpdateParents(double curtime);
+  /// Store the transforms of the dynamic physics objects computed at this logic frame.
+  void UpdatePhysicsInterpolation(double curtime, double framestep);
   void DupliGroupRecurse(KX_GameObject *groupobj, int level);
   bool IsObjectInGroup(KX_GameObject *gameobj)
   {
@@ -570,6 +620,8 @@ class KX_Scene : public CValue, public SCA_IScene {
   KX_PYMETHOD_DOC(KX_Scene, convertBlenderCollection);
   KX_PYMETHOD_DOC(KX_Scene, addOverlayCollection);
   KX_PYMETHOD_DOC(KX_Scene, removeOverlayCollection);
+  KX_PYMETHOD_DOC(KX_Scene, saveSnapshot);
+  KX_PYMETHOD_DOC(KX_Scene, loadSnapshot);
 
   /* attributes */
   static PyObject *pyattr_get_name(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
@@ -600,6 +652,11 @@ class KX_Scene : public CValue, public SCA_IScene {
   static int pyattr_set_gravity(PyObjectPlus *self_v,
                                 const KX_PYATTRIBUTE_DEF *attrdef,
                                 PyObject *value);
+  static PyObject *pyattr_get_pose_cache_frame_step(PyObjectPlus *self_v,
+                                                    const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_pose_cache_frame_step(PyObjectPlus *self_v,
+                                              const KX_PYATTRIBUTE_DEF *attrdef,
+                                              PyObject *value);
 
   /* getitem/setitem */
   static PyMappingMethods Mapping;
@@ -619,7 +676,15 @@ class KX_Scene : public CValue, public SCA_IScene {
     return m_blenderScene;
   }
 
+  /// Merge all the content of an other scene at once.
   bool MergeScene(KX_Scene *other);
+  /** Merge an other scene object by object until a deadline.
+   * The merged objects stay frozen and without logic until the last step which activates them
+   * all at once. At least one object is merged per call.
+   * \param deadline Time in seconds from PIL_check_seconds_timer(), 0 for no limit.
+   * \return True when the merge is complete, the other scene can then be deleted.
+   */
+  bool MergeSceneStep(KX_SceneMergeState &state, double deadline);
 
   // void PrintStats(int verbose_level) {
   //	m_bucketmanager->PrintStats(verbose_level)
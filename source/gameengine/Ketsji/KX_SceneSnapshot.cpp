@@ -0,0 +1,547 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_SceneSnapshot.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_SceneSnapshot.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "BLI_fileops.h"
+#include "BLI_task.h"
+#include "PIL_time.h"
+
+#include "BL_Action.h"
+#include "BL_ActionManager.h"
+#include "CM_Message.h"
+#include "EXP_BoolValue.h"
+#include "EXP_FloatValue.h"
+#include "EXP_IntValue.h"
+#include "EXP_StringValue.h"
+#include "KX_GameObject.h"
+#include "KX_Scene.h"
+#include "PHY_IPhysicsController.h"
+
+/// Bump when the layout of the snapshots changes.
+static const unsigned int snapshotVersion = 2;
+static const char snapshotMagic[4] = {'B', 'G', 'E', 'S'};
+
+template <class T> static void snapshot_write(std::vector<unsigned char> &buffer, const T &value)
+{
+  const unsigned char *data = (const unsigned char *)&value;
+  buffer.insert(buffer.end(), data, data + sizeof(T));
+}
+
+static void snapshot_write_string(std::vector<unsigned char> &buffer, const std::string &str)
+{
+  snapshot_write(buffer, (uint32_t)str.size());
+  buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+static void snapshot_write_vector(std::vector<unsigned char> &buffer, const MT_Vector3 &vec)
+{
+  for (unsigned short i = 0; i < 3; ++i) {
+    snapshot_write(buffer, (float)vec[i]);
+  }
+}
+
+template <class T>
+static bool snapshot_read(const std::vector<unsigned char> &buffer, size_t &offset, T &value)
+{
+  if (offset + sizeof(T) > buffer.size()) {
+    return false;
+  }
+  memcpy(&value, buffer.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return true;
+}
+
+static bool snapshot_read_string(const std::vector<unsigned char> &buffer,
+                                 size_t &offset,
+                                 std::string &str)
+{
+  uint32_t size;
+  if (!snapshot_read(buffer, offset, size) || offset + size > buffer.size()) {
+    return false;
+  }
+  str.assign((const char *)buffer.data() + offset, size);
+  offset += size;
+  return true;
+}
+
+static bool snapshot_read_vector(const std::vector<unsigned char> &buffer,
+                                 size_t &offset,
+                                 MT_Vector3 &vec)
+{
+  for (unsigned short i = 0; i < 3; ++i) {
+    float value;
+    if (!snapshot_read(buffer, offset, value)) {
+      return false;
+    }
+    vec[i] = value;
+  }
+  return true;
+}
+
+/// A file write done by the task pool.
+struct KX_SnapshotWriteTask {
+  std::string path;
+  std::vector<unsigned char> buffer;
+};
+
+static void snapshot_write_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  const KX_SnapshotWriteTask *task = (KX_SnapshotWriteTask *)taskdata;
+
+  /* Write to a temporary file first so that a crash never leaves a partial snapshot. The writes
+   * are serialized by the pool, the writes to the same path never share the temporary file. */
+  const std::string tmppath = task->path + ".tmp";
+  FILE *file = BLI_fopen(tmppath.c_str(), "wb");
+  if (!file) {
+    CM_Error("unable to write snapshot file \"" << task->path << "\"");
+    return;
+  }
+
+  const bool written = (fwrite(task->buffer.data(), task->buffer.size(), 1, file) == 1);
+  fclose(file);
+  if (!written || BLI_rename(tmppath.c_str(), task->path.c_str()) != 0) {
+    BLI_delete(tmppath.c_str(), false, false);
+    CM_Error("unable to write snapshot file \"" << task->path << "\"");
+  }
+}
+
+static void snapshot_write_task_free(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  delete (KX_SnapshotWriteTask *)taskdata;
+}
+
+KX_SceneSnapshot::KX_SceneSnapshot() : m_lastId(0)
+{
+  // The ids start from the time to not match the snapshots of a previous game.
+  m_nextId = (uint64_t)(PIL_check_seconds_timer() * 1.0e6) + 1;
+  m_pool = BLI_task_pool_create_background_serial(nullptr, TASK_PRIORITY_LOW);
+}
+
+KX_SceneSnapshot::~KX_SceneSnapshot()
+{
+  BLI_task_pool_work_and_wait(m_pool);
+  BLI_task_pool_free(m_pool);
+}
+
+void KX_SceneSnapshot::WriteObject(KX_GameObject *gameobj, std::vector<unsigned char> &record)
+{
+  snapshot_write_vector(record, gameobj->NodeGetLocalPosition());
+  const MT_Matrix3x3 &orientation = gameobj->NodeGetLocalOrientation();
+  for (unsigned short i = 0; i < 3; ++i) {
+    snapshot_write_vector(record, orientation[i]);
+  }
+  snapshot_write_vector(record, gameobj->NodeGetLocalScaling());
+
+  snapshot_write(record, (uint32_t)gameobj->GetState());
+
+  // Only the properties of simple types are stored, in name order.
+  std::vector<CValue *> properties;
+  std::vector<std::string> names;
+  for (const std::string &name : gameobj->GetPropertyNames()) {
+    CValue *prop = gameobj->GetProperty(name);
+    switch (prop->GetValueType()) {
+      case VALUE_INT_TYPE:
+      case VALUE_FLOAT_TYPE:
+      case VALUE_BOOL_TYPE:
+      case VALUE_STRING_TYPE: {
+        properties.push_back(prop);
+        names.push_back(name);
+        break;
+      }
+    }
+  }
+
+  snapshot_write(record, (uint32_t)properties.size());
+  for (unsigned int i = 0, size = properties.size(); i < size; ++i) {
+    CValue *prop = properties[i];
+    const unsigned char type = prop->GetValueType();
+    snapshot_write_string(record, names[i]);
+    snapshot_write(record, type);
+    switch (type) {
+      case VALUE_INT_TYPE: {
+        snapshot_write(record, (int64_t) static_cast<CIntValue *>(prop)->GetInt());
+        break;
+      }
+      case VALUE_FLOAT_TYPE: {
+        snapshot_write(record, static_cast<CFloatValue *>(prop)->GetFloat());
+        break;
+      }
+      case VALUE_BOOL_TYPE: {
+        snapshot_write(record, (unsigned char) static_cast<CBoolValue *>(prop)->GetBool());
+        break;
+      }
+      case VALUE_STRING_TYPE: {
+        snapshot_write_string(record, prop->GetText());
+        break;
+      }
+    }
+  }
+
+  std::vector<std::pair<short, BL_Action *>> actions;
+  BL_ActionManager *manager = gameobj->GetExistingActionManager();
+  if (manager) {
+    for (short layer : manager->GetActionLayers()) {
+      BL_Action *action = manager->GetAction(layer);
+      if (!action->GetName().empty()) {
+        actions.emplace_back(layer, action);
+      }
+    }
+  }
+
+  snapshot_write(record, (uint32_t)actions.size());
+  for (const std::pair<short, BL_Action *> &pair : actions) {
+    BL_Action *action = pair.second;
+    snapshot_write(record, pair.first);
+    snapshot_write_string(record, action->GetName());
+    snapshot_write(record, action->GetStartFrame());
+    snapshot_write(record, action->GetEndFrame());
+    snapshot_write(record, action->GetFrame());
+    snapshot_write(record, action->GetLayerWeight());
+    snapshot_write(record, action->GetSpeed());
+    snapshot_write(record, action->GetPriority());
+    snapshot_write(record, action->GetPlayMode());
+    snapshot_write(record, action->GetBlendMode());
+    snapshot_write(record, action->GetIpoFlags());
+  }
+
+  PHY_IPhysicsController *ctrl = gameobj->GetPhysicsController();
+  const unsigned char dynamic = (ctrl && ctrl->IsDynamic());
+  snapshot_write(record, dynamic);
+  if (dynamic) {
+    snapshot_write_vector(record, ctrl->GetLinearVelocity());
+    snapshot_write_vector(record, ctrl->GetAngularVelocity());
+  }
+}
+
+bool KX_SceneSnapshot::ReadObject(KX_GameObject *gameobj, const std::vector<unsigned char> &record)
+{
+  size_t offset = 0;
+
+  MT_Vector3 position;
+  MT_Matrix3x3 orientation;
+  MT_Vector3 scale;
+  uint32_t state;
+  if (!snapshot_read_vector(record, offset, position) ||
+      !snapshot_read_vector(record, offset, orientation[0]) ||
+      !snapshot_read_vector(record, offset, orientation[1]) ||
+      !snapshot_read_vector(record, offset, orientation[2]) ||
+      !snapshot_read_vector(record, offset, scale) || !snapshot_read(record, offset, state)) {
+    return false;
+  }
+
+  if (gameobj) {
+    gameobj->NodeSetLocalPosition(position);
+    gameobj->NodeSetLocalOrientation(orientation);
+    gameobj->NodeSetLocalScale(scale);
+    gameobj->NodeUpdateGS(0.0f);
+    gameobj->SetState(state);
+  }
+
+  uint32_t numProperties;
+  if (!snapshot_read(record, offset, numProperties)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < numProperties; ++i) {
+    std::string name;
+    unsigned char type;
+    if (!snapshot_read_string(record, offset, name) || !snapshot_read(record, offset, type)) {
+      return false;
+    }
+
+    CValue *prop = nullptr;
+    switch (type) {
+      case VALUE_INT_TYPE: {
+        int64_t value;
+        if (!snapshot_read(record, offset, value)) {
+          return false;
+        }
+        prop = gameobj ? new CIntValue((cInt)value) : nullptr;
+        break;
+      }
+      case VALUE_FLOAT_TYPE: {
+        float value;
+        if (!snapshot_read(record, offset, value)) {
+          return false;
+        }
+        prop = gameobj ? new CFloatValue(value) : nullptr;
+        break;
+      }
+      case VALUE_BOOL_TYPE: {
+        unsigned char value;
+        if (!snapshot_read(record, offset, value)) {
+          return false;
+        }
+        prop = gameobj ? new CBoolValue(value != 0) : nullptr;
+        break;
+      }
+      case VALUE_STRING_TYPE: {
+        std::string value;
+        if (!snapshot_read_string(record, offset, value)) {
+          return false;
+        }
+        prop = gameobj ? new CStringValue(value, name) : nullptr;
+        break;
+      }
+      default: {
+        return false;
+      }
+    }
+
+    if (prop) {
+      // Keep the existing property values, they can be referenced by logic bricks.
+      CValue *oldprop = gameobj->GetProperty(name);
+      if (oldprop && oldprop->GetValueType() == prop->GetValueType()) {
+        oldprop->SetValue(prop);
+        gameobj->PropertiesChanged();
+      }
+      else {
+        gameobj->SetProperty(name, prop);
+      }
+      prop->Release();
+    }
+  }
+
+  uint32_t numActions;
+  if (!snapshot_read(record, offset, numActions)) {
+    return false;
+  }
+
+  std::vector<short> layers;
+  for (uint32_t i = 0; i < numActions; ++i) {
+    short layer;
+    std::string name;
+    float start, end, frame, layerWeight, speed;
+    short priority, playMode, blendMode, ipoFlags;
+    if (!snapshot_read(record, offset, layer) || !snapshot_read_string(record, offset, name) ||
+        !snapshot_read(record, offset, start) || !snapshot_read(record, offset, end) ||
+        !snapshot_read(record, offset, frame) || !snapshot_read(record, offset, layerWeight) ||
+        !snapshot_read(record, offset, speed) || !snapshot_read(record, offset, priority) ||
+        !snapshot_read(record, offset, playMode) || !snapshot_read(record, offset, blendMode) ||
+        !snapshot_read(record, offset, ipoFlags)) {
+      return false;
+    }
+
+    if (gameobj) {
+      gameobj->PlayAction(
+          name, start, end, layer, priority, 0.0f, playMode, layerWeight, ipoFlags, speed,
+          blendMode);
+      gameobj->SetActionFrame(layer, frame);
+      layers.push_back(layer);
+    }
+  }
+
+  // Stop the actions played since the snapshot.
+  BL_ActionManager *manager = gameobj ? gameobj->GetExistingActionManager() : nullptr;
+  if (manager) {
+    for (short layer : manager->GetActionLayers()) {
+      if (std::find(layers.begin(), layers.end(), layer) == layers.end()) {
+        gameobj->StopAction(layer);
+      }
+    }
+  }
+
+  unsigned char dynamic;
+  if (!snapshot_read(record, offset, dynamic)) {
+    return false;
+  }
+  if (dynamic) {
+    MT_Vector3 linearVelocity;
+    MT_Vector3 angularVelocity;
+    if (!snapshot_read_vector(record, offset, linearVelocity) ||
+        !snapshot_read_vector(record, offset, angularVelocity)) {
+      return false;
+    }
+
+    PHY_IPhysicsController *ctrl = gameobj ? gameobj->GetPhysicsController() : nullptr;
+    if (ctrl && ctrl->IsDynamic()) {
+      ctrl->SetLinearVelocity(linearVelocity, false);
+      ctrl->SetAngularVelocity(angularVelocity, false);
+    }
+  }
+
+  return (offset == record.size());
+}
+
+void KX_SceneSnapshot::Save(KX_Scene *scene, bool delta, std::vector<unsigned char> &buffer)
+{
+  // A delta needs a previous snapshot, the first one is always complete.
+  delta = delta && (m_lastId != 0);
+  const uint64_t id = m_nextId++;
+
+  buffer.clear();
+  buffer.insert(buffer.end(), snapshotMagic, snapshotMagic + sizeof(snapshotMagic));
+  snapshot_write(buffer, (uint32_t)snapshotVersion);
+  snapshot_write(buffer, (unsigned char)delta);
+  snapshot_write(buffer, id);
+  // The snapshot a delta applies to.
+  snapshot_write(buffer, delta ? m_lastId : (uint64_t)0);
+
+  // The number of objects is written once known.
+  const size_t countOffset = buffer.size();
+  snapshot_write(buffer, (uint32_t)0);
+  uint32_t count = 0;
+
+  if (!delta) {
+    m_records.clear();
+  }
+  m_lastId = id;
+
+  std::map<std::string, unsigned int> indices;
+  std::vector<unsigned char> record;
+  for (KX_GameObject *gameobj : scene->GetObjectList()) {
+    const std::string name = gameobj->GetName();
+    const ObjectKey key(name, indices[name]++);
+
+    record.clear();
+    WriteObject(gameobj, record);
+
+    std::vector<unsigned char> &lastRecord = m_records[key];
+    if (delta && lastRecord == record) {
+      continue;
+    }
+    lastRecord = record;
+
+    snapshot_write_string(buffer, key.first);
+    snapshot_write(buffer, (uint32_t)key.second);
+    snapshot_write(buffer, (uint32_t)record.size());
+    buffer.insert(buffer.end(), record.begin(), record.end());
+    ++count;
+  }
+
+  memcpy(buffer.data() + countOffset, &count, sizeof(count));
+}
+
+bool KX_SceneSnapshot::Load(KX_Scene *scene, const std::vector<unsigned char> &buffer)
+{
+  size_t offset = sizeof(snapshotMagic);
+  uint32_t version;
+  unsigned char delta;
+  uint64_t id;
+  uint64_t baseId;
+  uint32_t count;
+  if (buffer.size() < sizeof(snapshotMagic) ||
+      memcmp(buffer.data(), snapshotMagic, sizeof(snapshotMagic)) != 0 ||
+      !snapshot_read(buffer, offset, version) || version != snapshotVersion ||
+      !snapshot_read(buffer, offset, delta) || !snapshot_read(buffer, offset, id) ||
+      !snapshot_read(buffer, offset, baseId) || !snapshot_read(buffer, offset, count)) {
+    return false;
+  }
+
+  // A delta only applies over the snapshot it was saved from.
+  if (delta && baseId != m_lastId) {
+    return false;
+  }
+
+  /* The whole snapshot is checked before restoring anything, an invalid file leaves the scene
+   * untouched. */
+  std::vector<std::pair<ObjectKey, std::vector<unsigned char>>> records;
+  for (uint32_t i = 0; i < count; ++i) {
+    ObjectKey key;
+    uint32_t index;
+    uint32_t size;
+    if (!snapshot_read_string(buffer, offset, key.first) ||
+        !snapshot_read(buffer, offset, index) || !snapshot_read(buffer, offset, size) ||
+        offset + size > buffer.size()) {
+      return false;
+    }
+    key.second = index;
+
+    std::vector<unsigned char> record(buffer.begin() + offset, buffer.begin() + offset + size);
+    offset += size;
+
+    if (!ReadObject(nullptr, record)) {
+      return false;
+    }
+    records.emplace_back(key, std::move(record));
+  }
+
+  if (offset != buffer.size()) {
+    return false;
+  }
+
+  std::map<ObjectKey, KX_GameObject *> objects;
+  std::map<std::string, unsigned int> indices;
+  for (KX_GameObject *gameobj : scene->GetObjectList()) {
+    const std::string name = gameobj->GetName();
+    objects[ObjectKey(name, indices[name]++)] = gameobj;
+  }
+
+  if (!delta) {
+    m_records.clear();
+  }
+  m_lastId = id;
+
+  for (std::pair<ObjectKey, std::vector<unsigned char>> &pair : records) {
+    // The objects removed since the snapshot are ignored.
+    std::map<ObjectKey, KX_GameObject *>::iterator it = objects.find(pair.first);
+    if (it == objects.end()) {
+      continue;
+    }
+
+    ReadObject(it->second, pair.second);
+    m_records[pair.first] = std::move(pair.second);
+  }
+
+  return true;
+}
+
+void KX_SceneSnapshot::WriteFile(const std::string &path, std::vector<unsigned char> &&buffer)
+{
+  KX_SnapshotWriteTask *task = new KX_SnapshotWriteTask{path, std::move(buffer)};
+  BLI_task_pool_push(m_pool, snapshot_write_task, task, true, snapshot_write_task_free);
+}
+
+bool KX_SceneSnapshot::ReadFile(const std::string &path, std::vector<unsigned char> &buffer)
+{
+  WaitWrites();
+
+  FILE *file = BLI_fopen(path.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+
+  fseek(file, 0, SEEK_END);
+  const long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  bool read = (size >= 0);
+  if (read) {
+    buffer.resize(size);
+    read = (size == 0 || fread(buffer.data(), size, 1, file) == 1);
+  }
+  fclose(file);
+
+  return read;
+}
+
+void KX_SceneSnapshot::WaitWrites()
+{
+  BLI_task_pool_work_and_wait(m_pool);
+}
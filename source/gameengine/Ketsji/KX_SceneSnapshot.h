@@ -0,0 +1,87 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SceneSnapshot.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class KX_Scene;
+class KX_GameObject;
+struct TaskPool;
+
+/** \brief Binary snapshot of the game state of a scene.
+ * A snapshot stores for each object its local transform, logic state, game properties, playing
+ * actions and physics velocities. The objects are identified by their name and their order among
+ * the objects of the same name, the objects added or removed since the snapshot are then not
+ * recreated. A delta snapshot stores only the objects changed since the previous snapshot and
+ * is only loaded over this snapshot, identified by its id.
+ */
+class KX_SceneSnapshot {
+ private:
+  /// Object name and index among the objects of the same name.
+  using ObjectKey = std::pair<std::string, unsigned int>;
+
+  /// Serialized state of the objects at the last saved or loaded snapshot.
+  std::map<ObjectKey, std::vector<unsigned char>> m_records;
+
+  /// Id of the last saved or loaded snapshot, the base of the next delta, 0 if none.
+  uint64_t m_lastId;
+  /// Id of the next saved snapshot.
+  uint64_t m_nextId;
+
+  /// Pool of the file writes, run serially in the order of the saves.
+  TaskPool *m_pool;
+
+  static void WriteObject(KX_GameObject *gameobj, std::vector<unsigned char> &record);
+  /** Restore the state of an object from its record.
+   * \param gameobj The object to restore, nullptr to only check the record.
+   * \return False if the record is invalid, the object may then be partially restored.
+   */
+  static bool ReadObject(KX_GameObject *gameobj, const std::vector<unsigned char> &record);
+
+ public:
+  KX_SceneSnapshot();
+  ~KX_SceneSnapshot();
+
+  /** Serialize the state of the scene objects.
+   * \param delta Store only the objects changed since the previous snapshot.
+   */
+  void Save(KX_Scene *scene, bool delta, std::vector<unsigned char> &buffer);
+  /** Restore the state of the scene objects, nothing is restored if the buffer is invalid.
+   * \return False if the buffer is not a valid snapshot or is a delta of another snapshot than
+   * the last saved or loaded one.
+   */
+  bool Load(KX_Scene *scene, const std::vector<unsigned char> &buffer);
+
+  /// Write a snapshot to a file in a worker thread.
+  void WriteFile(const std::string &path, std::vector<unsigned char> &&buffer);
+  /// Read a snapshot file, after waiting for the pending writes.
+  bool ReadFile(const std::string &path, std::vector<unsigned char> &buffer);
+  /// Wait for the pending file writes.
+  void WaitWrites();
+};
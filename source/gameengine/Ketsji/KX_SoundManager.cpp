@@ -0,0 +1,146 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_SoundManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_SoundManager.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef WITH_AUDASPACE
+#  include <AUD_Device.h>
+#  include <AUD_Handle.h>
+#endif
+
+#include "SCA_SoundActuator.h"
+
+KX_SoundManager::KX_SoundManager() : m_maxVoices(0), m_stats({0, 0})
+{
+}
+
+KX_SoundManager::~KX_SoundManager()
+{
+}
+
+void KX_SoundManager::AddSource(SCA_SoundActuator *actuator,
+                                const float location[3],
+                                const float velocity[3],
+                                const float orientation[4],
+                                float priority)
+{
+  Source source;
+  source.m_actuator = actuator;
+  memcpy(source.m_location, location, sizeof(source.m_location));
+  memcpy(source.m_velocity, velocity, sizeof(source.m_velocity));
+  memcpy(source.m_orientation, orientation, sizeof(source.m_orientation));
+  source.m_priority = priority;
+
+  m_sources.push_back(source);
+}
+
+void KX_SoundManager::RemoveSource(SCA_SoundActuator *actuator)
+{
+  m_sources.erase(std::remove_if(m_sources.begin(),
+                                 m_sources.end(),
+                                 [actuator](const Source &source) {
+                                   return source.m_actuator == actuator;
+                                 }),
+                  m_sources.end());
+}
+
+void KX_SoundManager::Flush()
+{
+  m_stats.m_sources = m_sources.size();
+  m_stats.m_culled = 0;
+
+  if (m_sources.empty()) {
+    return;
+  }
+
+#ifdef WITH_AUDASPACE
+  unsigned int voices = m_sources.size();
+  if (m_maxVoices > 0 && voices > m_maxVoices) {
+    // Only the most audible sources are played, their order doesn't matter.
+    std::nth_element(m_sources.begin(),
+                     m_sources.begin() + m_maxVoices,
+                     m_sources.end(),
+                     [](const Source &a, const Source &b) { return a.m_priority > b.m_priority; });
+    voices = m_maxVoices;
+  }
+
+  AUD_Device *device = AUD_Device_getCurrent();
+  if (device) {
+    // Hold the device lock once so the mixing thread doesn't wait between each update.
+    AUD_Device_lock(device);
+  }
+
+  for (unsigned int i = 0, size = m_sources.size(); i < size; ++i) {
+    const Source &source = m_sources[i];
+    SCA_SoundActuator *actuator = source.m_actuator;
+    AUD_Handle *handle = actuator->GetHandle();
+    // The sound could have been stopped after its submission.
+    if (!handle) {
+      continue;
+    }
+
+    if (i < voices) {
+      if (actuator->GetCulled()) {
+        AUD_Handle_resume(handle);
+        actuator->SetCulled(false);
+      }
+      AUD_Handle_setLocation(handle, source.m_location);
+      AUD_Handle_setVelocity(handle, source.m_velocity);
+      AUD_Handle_setOrientation(handle, source.m_orientation);
+    }
+    else {
+      if (!actuator->GetCulled()) {
+        AUD_Handle_pause(handle);
+        actuator->SetCulled(true);
+      }
+      ++m_stats.m_culled;
+    }
+  }
+
+  if (device) {
+    AUD_Device_unlock(device);
+    AUD_Device_free(device);
+  }
+#endif  // WITH_AUDASPACE
+
+  m_sources.clear();
+}
+
+unsigned int KX_SoundManager::GetMaxVoices() const
+{
+  return m_maxVoices;
+}
+
+void KX_SoundManager::SetMaxVoices(unsigned int voices)
+{
+  m_maxVoices = voices;
+}
+
+const KX_SoundManager::Stats &KX_SoundManager::GetStats() const
+{
+  return m_stats;
+}
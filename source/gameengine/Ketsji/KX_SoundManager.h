@@ -0,0 +1,84 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SoundManager.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <vector>
+
+class SCA_SoundActuator;
+
+/** \brief Batch of the 3D sound source updates of a logic frame.
+ * The sound actuators submit the camera relative location, velocity and orientation of their
+ * playing 3D sounds, the manager sends them to the audio device under a single device lock
+ * instead of locking the device for each parameter of each sound. When a voice limit is set,
+ * the least audible sources over the limit are paused until they become audible enough again.
+ */
+class KX_SoundManager {
+ public:
+  /// Counters of the last flushed logic frame.
+  struct Stats {
+    /// Number of 3D sources submitted.
+    unsigned int m_sources;
+    /// Number of sources paused by the voice limit.
+    unsigned int m_culled;
+  };
+
+ private:
+  struct Source {
+    SCA_SoundActuator *m_actuator;
+    float m_location[3];
+    float m_velocity[3];
+    float m_orientation[4];
+    /// Estimated gain of the source at the listener, used to sort the sources.
+    float m_priority;
+  };
+
+  std::vector<Source> m_sources;
+  /// Maximum number of playing 3D sources, zero for no limit.
+  unsigned int m_maxVoices;
+  Stats m_stats;
+
+ public:
+  KX_SoundManager();
+  ~KX_SoundManager();
+
+  /** Queue the parameters of a playing 3D sound for the next flush.
+   * \param priority The estimated gain of the sound at the listener.
+   */
+  void AddSource(SCA_SoundActuator *actuator,
+                 const float location[3],
+                 const float velocity[3],
+                 const float orientation[4],
+                 float priority);
+  /// Remove the queued parameters of a deleted actuator.
+  void RemoveSource(SCA_SoundActuator *actuator);
+
+  /// Send the queued parameters to the audio device and apply the voice limit.
+  void Flush();
+
+  unsigned int GetMaxVoices() const;
+  void SetMaxVoices(unsigned int voices);
+
+  const Stats &GetStats() const;
+};
@@ -41,6 +41,7 @@
 #include "LinearMath/btConvexHull.h"
 
 #include "CcdPhysicsEnvironment.h"
+#include "CcdShapeCache.h"
 #include "KX_GameObject.h"
 #include "RAS_DisplayArray.h"
 #include "RAS_MeshObject.h"
@@ -66,6 +67,76 @@ BlenderBulletCharacterController::BlenderBulletCharacterController(CcdPhysicsCon
       m_jumps(0),
       m_maxJumps(1)
 {
+  m_restCache.m_valid = false;
+}
+
+static bool character_state_equal(const BlenderBulletCharacterController::State &a,
+                                  const BlenderBulletCharacterController::State &b)
+{
+  return a.m_walkDirection == b.m_walkDirection &&
+         a.m_normalizedDirection == b.m_normalizedDirection &&
+         a.m_verticalVelocity == b.m_verticalVelocity &&
+         a.m_verticalOffset == b.m_verticalOffset &&
+         a.m_velocityTimeInterval == b.m_velocityTimeInterval &&
+         a.m_wasOnGround == b.m_wasOnGround && a.m_wasJumping == b.m_wasJumping &&
+         a.m_useWalkDirection == b.m_useWalkDirection && a.m_jumps == b.m_jumps;
+}
+
+bool BlenderBulletCharacterController::MatchRestCache(btScalar dt) const
+{
+  const RestCache &cache = m_restCache;
+  if (cache.m_timeStep != dt || cache.m_gravity != m_gravity ||
+      cache.m_maxSlopeCosine != m_maxSlopeCosine || cache.m_stepHeight != m_stepHeight ||
+      !(cache.m_transform == m_ghostObject->getWorldTransform()) ||
+      !character_state_equal(cache.m_state, GetState())) {
+    return false;
+  }
+
+  // Any moved, added or removed object around the character can change its ground contact.
+  const int numOverlaps = m_ghostObject->getNumOverlappingObjects();
+  if ((unsigned int)numOverlaps != cache.m_overlaps.size()) {
+    return false;
+  }
+  for (int i = 0; i < numOverlaps; ++i) {
+    const btCollisionObject *obj = m_ghostObject->getOverlappingObject(i);
+    const std::pair<const btCollisionObject *, btTransform> &overlap = cache.m_overlaps[i];
+    if (overlap.first != obj || !(overlap.second == obj->getWorldTransform())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void BlenderBulletCharacterController::UpdateRestCache(btScalar dt,
+                                                       const State &prevState,
+                                                       const btTransform &prevTransform)
+{
+  const State state = GetState();
+  const btTransform &transform = m_ghostObject->getWorldTransform();
+  /* Only a character without walk direction is at rest, the absolute tolerance allows the float
+   * noise of the step up and step down sweeps of a character on ground. */
+  const btScalar tolerance = 1.0e-4f;
+  m_restCache.m_valid = m_AngVel.fuzzyZero() && state.m_walkDirection.isZero() &&
+                        character_state_equal(state, prevState) &&
+                        transform.getBasis() == prevTransform.getBasis() &&
+                        transform.getOrigin().distance2(prevTransform.getOrigin()) <
+                            tolerance * tolerance;
+  if (!m_restCache.m_valid) {
+    return;
+  }
+
+  m_restCache.m_timeStep = dt;
+  m_restCache.m_gravity = m_gravity;
+  m_restCache.m_maxSlopeCosine = m_maxSlopeCosine;
+  m_restCache.m_stepHeight = m_stepHeight;
+  m_restCache.m_transform = transform;
+  m_restCache.m_state = state;
+  m_restCache.m_overlaps.clear();
+  for (int i = 0, size = m_ghostObject->getNumOverlappingObjects(); i < size; ++i) {
+    const btCollisionObject *obj = m_ghostObject->getOverlappingObject(i);
+    m_restCache.m_overlaps.emplace_back(obj, obj->getWorldTransform());
+  }
 }
 
 void BlenderBulletCharacterController::updateAction(btCollisionWorld *collisionWorld, btScalar dt)
@@ -73,8 +144,18 @@ void BlenderBulletCharacterController::updateAction(btCollisionWorld *collisionW
   if (onGround())
     m_jumps = 0;
 
+  // A character at rest in unchanged surroundings keeps its transform and ground contact.
+  if (m_restCache.m_valid && MatchRestCache(dt)) {
+    return;
+  }
+
+  const State prevState = GetState();
+  const btTransform prevTransform = m_ghostObject->getWorldTransform();
+
   btKinematicCharacterController::updateAction(collisionWorld, dt);
   m_motionState->setWorldTransform(getGhostObject()->getWorldTransform());
+
+  UpdateRestCache(dt, prevState, prevTransform);
 }
 
 unsigned char BlenderBulletCharacterController::getMaxJumps() const
@@ -112,6 +193,36 @@ const btVector3 &BlenderBulletCharacterController::getWalkDirection()
   return m_walkDirection;
 }
 
+BlenderBulletCharacterController::State BlenderBulletCharacterController::GetState() const
+{
+  State state;
+  state.m_walkDirection = m_walkDirection;
+  state.m_normalizedDirection = m_normalizedDirection;
+  state.m_verticalVelocity = m_verticalVelocity;
+  state.m_verticalOffset = m_verticalOffset;
+  state.m_velocityTimeInterval = m_velocityTimeInterval;
+  state.m_wasOnGround = m_wasOnGround;
+  state.m_wasJumping = m_wasJumping;
+  state.m_useWalkDirection = m_useWalkDirection;
+  state.m_jumps = m_jumps;
+  return state;
+}
+
+void BlenderBulletCharacterController::SetState(const State &state)
+{
+  m_walkDirection = state.m_walkDirection;
+  m_normalizedDirection = state.m_normalizedDirection;
+  m_verticalVelocity = state.m_verticalVelocity;
+  m_verticalOffset = state.m_verticalOffset;
+  m_velocityTimeInterval = state.m_velocityTimeInterval;
+  m_wasOnGround = state.m_wasOnGround;
+  m_wasJumping = state.m_wasJumping;
+  m_useWalkDirection = state.m_useWalkDirection;
+  m_jumps = state.m_jumps;
+  // The cached rest step may not match the restored state.
+  m_restCache.m_valid = false;
+}
+
 float BlenderBulletCharacterController::GetFallSpeed() const
 {
   return m_fallSpeed;
@@ -190,6 +301,8 @@ CcdPhysicsController::CcdPhysicsController(const CcdConstructionInfo &ci) : m_cc
   m_newClientInfo = 0;
   m_registerCount = 0;
   m_softBodyTransformInitialized = false;
+  m_softBodyMeshSynced = false;
+  m_softBodyVertexNodesMesh = nullptr;
   m_parentCtrl = 0;
   // copy pointers locally to allow smart release
   m_MotionState = ci.m_MotionState;
@@ -213,6 +326,7 @@ CcdPhysicsController::CcdPhysicsController(const CcdConstructionInfo &ci) : m_cc
   m_savedMass = 0.0f;
   m_savedDyna = false;
   m_suspended = false;
+  m_savedActivationState = 0;
 
   CreateRigidbody();
 }
@@ -706,6 +820,9 @@ bool CcdPhysicsController::ReplaceControllerShape(btCollisionShape *newShape)
     m_softbodyMappingDone = false;
     m_prototypeTransformInitialized = false;
     m_softBodyTransformInitialized = false;
+    // The nodes of the new soft body don't match the vertex mapping.
+    m_softBodyVertexNodesMesh = nullptr;
+    m_softBodyMeshSynced = false;
 
     CreateSoftbody();
     BLI_assert(m_object);
@@ -771,6 +888,27 @@ void CcdPhysicsController::SimulationTick(float timestep)
   }
 }
 
+/// Return true when the motion state already matches the transform, up to the float noise.
+static bool motion_state_equal(PHY_IMotionState *motionState, const btTransform &xform)
+{
+  const btVector3 &origin = xform.getOrigin();
+  const btScalar tolerance = 4.0f * SIMD_EPSILON * btMax(btScalar(1.0f), origin.length());
+  if (ToBullet(motionState->GetWorldPosition()).distance2(origin) > tolerance * tolerance) {
+    return false;
+  }
+
+  const btMatrix3x3 &basis = xform.getBasis();
+  const btMatrix3x3 ori = ToBullet(motionState->GetWorldOrientation());
+  const btScalar oriTolerance = 4.0f * SIMD_EPSILON;
+  for (unsigned short i = 0; i < 3; ++i) {
+    if (ori[i].distance2(basis[i]) > oriTolerance * oriTolerance) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /**
  * SynchronizeMotionStates ynchronizes dynas, kinematic and deformable entities (and do 'late
  * binding')
@@ -810,7 +948,10 @@ bool CcdPhysicsController::SynchronizeMotionStates(float time)
 
   btRigidBody *body = GetRigidBody();
 
-  if (body && !body->isStaticObject()) {
+  // Writing the motion state marks the node modified and schedules its scene graph update,
+  // a sleeping or barely moving body is then skipped.
+  if (body && !body->isStaticObject() &&
+      !motion_state_equal(m_MotionState, body->getCenterOfMassTransform())) {
     const btTransform &xform = body->getCenterOfMassTransform();
     const btMatrix3x3 &worldOri = xform.getBasis();
     const btVector3 &worldPos = xform.getOrigin();
@@ -819,101 +960,128 @@ bool CcdPhysicsController::SynchronizeMotionStates(float time)
     m_MotionState->CalculateWorldTransformations();
   }
 
-  const MT_Vector3 &scale = m_MotionState->GetWorldScaling();
-  GetCollisionShape()->setLocalScaling(ToBullet(scale));
+  // Some shapes recompute their bounds for any new scaling, even an unchanged one.
+  const btVector3 scale = ToBullet(m_MotionState->GetWorldScaling());
+  btCollisionShape *shape = GetCollisionShape();
+  if (shape->getLocalScaling() != scale) {
+    shape->setLocalScaling(scale);
+  }
 
   return true;
 }
 
-void CcdPhysicsController::UpdateSoftBody()
+void CcdPhysicsController::InitSoftBodyVertexNodes(RAS_MeshObject *rasMesh, Mesh *me)
 {
-  btSoftBody *sb = GetSoftBody();
-  if (sb && sb->getActivationState() != ISLAND_SLEEPING) {
-    if (sb->m_pose.m_bframe) {
-
-      RAS_MeshObject *rasMesh = GetShapeInfo()->GetMesh();
+  // I don't see how we could do without DerivedMesh...
+  DerivedMesh *dm = CDDM_from_mesh(me);
 
-      if (rasMesh) {
-        // Get other mesh data
-        Mesh *me = rasMesh->GetOrigMesh();
-        // I don't see how we could do without DerivedMesh...
-        DerivedMesh *dm = CDDM_from_mesh(me);
+  // Some meshes with modifiers returns 0 polys, call DM_ensure_tessface avoid this.
+  DM_ensure_tessface(dm);
 
-        // Some meshes with modifiers returns 0 polys, call DM_ensure_tessface avoid this.
-        DM_ensure_tessface(dm);
+  const int *index_mf_to_mpoly = (const int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
+  const int *index_mp_to_orig = (const int *)dm->getPolyDataArray(dm, CD_ORIGINDEX);
+  if (!index_mf_to_mpoly) {
+    index_mp_to_orig = nullptr;
+  }
 
-        const int *index_mf_to_mpoly = (const int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
-        const int *index_mp_to_orig = (const int *)dm->getPolyDataArray(dm, CD_ORIGINDEX);
-        if (!index_mf_to_mpoly) {
-          index_mp_to_orig = nullptr;
+  MFace *mface = dm->getTessFaceArray(dm);
+  const int numpolys = dm->getNumTessFaces(dm);
+  const int numnodes = GetSoftBody()->m_nodes.size();
+
+  m_softBodyVertexNodes.assign(me->totvert, -1);
+  m_softBodyVertexNodesMesh = me;
+
+  for (int p2 = 0; p2 < numpolys; p2++) {
+    MFace *mf = &mface[p2];
+    const int origi = index_mf_to_mpoly ?
+                          DM_origindex_mface_mpoly(index_mf_to_mpoly, index_mp_to_orig, p2) :
+                          p2;
+    RAS_Polygon *poly = (origi != ORIGINDEX_NONE) ? rasMesh->GetPolygon(origi) : nullptr;
+
+    // only the polygons that have the collisionflag set are simulated
+    if (poly) {
+      const unsigned int verts[4] = {mf->v1, mf->v2, mf->v3, mf->v4};
+      for (unsigned short i = 0, size = (mf->v4 ? 4 : 3); i < size; ++i) {
+        const int index = poly->GetVertexInfo(i).getSoftBodyIndex();
+        if (index >= 0 && index < numnodes) {
+          m_softBodyVertexNodes[verts[i]] = index;
         }
+      }
+    }
+  }
 
-        MVert *mverts = dm->getVertArray(dm);
-        MFace *mface = dm->getTessFaceArray(dm);
-        int numpolys = dm->getNumTessFaces(dm);
-
-        btSoftBody::tNodeArray &nodes(sb->m_nodes);
-        bContext *C = KX_GetActiveEngine()->GetContext();
-        Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
-        Object *ob = DEG_get_evaluated_object(depsgraph, rasMesh->GetOriginalObject());
-
-        for (int p2 = 0; p2 < numpolys; p2++) {
-          MFace *mf = &mface[p2];
-          const int origi = index_mf_to_mpoly ?
-                                DM_origindex_mface_mpoly(index_mf_to_mpoly, index_mp_to_orig, p2) :
-                                p2;
-          RAS_Polygon *poly = (origi != ORIGINDEX_NONE) ? rasMesh->GetPolygon(origi) : nullptr;
+  dm->release(dm);
+}
 
-          // only add polygons that have the collisionflag set
-          if (poly) {
-            MVert *v1 = &mverts[mf->v1];
-            MVert *v2 = &mverts[mf->v2];
-            MVert *v3 = &mverts[mf->v3];
+Mesh *CcdPhysicsController::BeginSoftBodyUpdate()
+{
+  btSoftBody *sb = GetSoftBody();
+  if (!sb || !sb->m_pose.m_bframe) {
+    return nullptr;
+  }
 
-            int i1 = poly->GetVertexInfo(0).getSoftBodyIndex();
-            int i2 = poly->GetVertexInfo(1).getSoftBodyIndex();
-            int i3 = poly->GetVertexInfo(2).getSoftBodyIndex();
+  // A sleeping soft body doesn't move, unless its mesh was not updated while invisible.
+  if (sb->getActivationState() == ISLAND_SLEEPING && m_softBodyMeshSynced) {
+    return nullptr;
+  }
 
-            MT_Vector3 p1 = ToMoto(nodes.at(i1).m_x - sb->m_pose.m_com);
-            MT_Vector3 p2 = ToMoto(nodes.at(i2).m_x - sb->m_pose.m_com);
-            MT_Vector3 p3 = ToMoto(nodes.at(i3).m_x - sb->m_pose.m_com);
+  RAS_MeshObject *rasMesh = GetShapeInfo()->GetMesh();
+  if (!rasMesh) {
+    return nullptr;
+  }
 
-            MT_Vector3 n1 = ToMoto(nodes.at(i1).m_n);
-            MT_Vector3 n2 = ToMoto(nodes.at(i2).m_n);
-            MT_Vector3 n3 = ToMoto(nodes.at(i3).m_n);
+  KX_GameObject *gameobj = KX_GameObject::GetClientObject(
+      (KX_ClientObjectInfo *)m_newClientInfo);
+  if (gameobj && !gameobj->GetVisible()) {
+    m_softBodyMeshSynced = false;
+    return nullptr;
+  }
 
-            // Do we need obmat? maybe
-            copy_v3_v3(v1->co, p1.getValue());
-            copy_v3_v3(v2->co, p2.getValue());
-            copy_v3_v3(v3->co, p3.getValue());
+  Mesh *me = rasMesh->GetOrigMesh();
+  if (m_softBodyVertexNodesMesh != me || m_softBodyVertexNodes.size() != (size_t)me->totvert) {
+    InitSoftBodyVertexNodes(rasMesh, me);
+  }
 
-            normal_float_to_short_v3(v1->no, n1.getValue());
-            normal_float_to_short_v3(v2->no, n2.getValue());
-            normal_float_to_short_v3(v3->no, n3.getValue());
+  return me;
+}
 
-            if (mf->v4) {
-              MVert *v4 = &mverts[mf->v4];
+void CcdPhysicsController::UpdateSoftBodyVertices(Mesh *me, int start, int end)
+{
+  btSoftBody *sb = GetSoftBody();
+  const btSoftBody::tNodeArray &nodes = sb->m_nodes;
+  const btVector3 &com = sb->m_pose.m_com;
 
-              int i4 = poly->GetVertexInfo(3).getSoftBodyIndex();
+  for (int i = start; i < end; ++i) {
+    const int index = m_softBodyVertexNodes[i];
+    if (index == -1) {
+      continue;
+    }
 
-              MT_Vector3 p4 = ToMoto(nodes.at(i4).m_x - sb->m_pose.m_com);
+    // The node normals are kept up to date by the solver, nothing to recompute.
+    const btSoftBody::Node &node = nodes[index];
+    const btVector3 co = node.m_x - com;
+    const float no[3] = {float(node.m_n.x()), float(node.m_n.y()), float(node.m_n.z())};
 
-              MT_Vector3 n4 = ToMoto(nodes.at(i4).m_n);
+    MVert &mvert = me->mvert[i];
+    mvert.co[0] = co.x();
+    mvert.co[1] = co.y();
+    mvert.co[2] = co.z();
+    normal_float_to_short_v3(mvert.no, no);
+  }
+}
 
-              copy_v3_v3(v4->co, p4.getValue());
+void CcdPhysicsController::EndSoftBodyUpdate(Mesh *me)
+{
+  DEG_id_tag_update(&me->id, ID_RECALC_GEOMETRY);
+  m_softBodyMeshSynced = true;
+}
 
-              normal_float_to_short_v3(v4->no, n4.getValue());
-            }
-          }
-        }
-        DM_to_mesh(dm,
-                   me,
-                   rasMesh->GetOriginalObject(),
-                   &CD_MASK_MESH,
-                   true);  // if take_ownership is true, dm is freed
-        DEG_id_tag_update(&me->id, ID_RECALC_GEOMETRY);
-      }
-    }
+void CcdPhysicsController::UpdateSoftBody()
+{
+  Mesh *me = BeginSoftBodyUpdate();
+  if (me) {
+    UpdateSoftBodyVertices(me, 0, me->totvert);
+    EndSoftBodyUpdate(me);
   }
 }
 
@@ -937,8 +1105,11 @@ void CcdPhysicsController::PostProcessReplica(class PHY_IMotionState *motionstat
 {
   SetParentCtrl((CcdPhysicsController *)parentctrl);
   m_softBodyTransformInitialized = false;
+  m_softBodyMeshSynced = false;
+  m_softBodyVertexNodesMesh = nullptr;
   m_MotionState = motionstate;
   m_registerCount = 0;
+  m_savedActivationState = 0;
   m_collisionShape = nullptr;
 
   // Clear all old constraints.
@@ -1456,6 +1627,18 @@ void CcdPhysicsController::Jump()
 
 void CcdPhysicsController::SetActive(bool active)
 {
+  btCollisionObject *obj = GetCollisionObject();
+  if (!active) {
+    // Keep the object in the world but frozen, the other objects collide with it as static.
+    if (m_savedActivationState == 0) {
+      m_savedActivationState = obj->getActivationState();
+      obj->forceActivationState(DISABLE_SIMULATION);
+    }
+  }
+  else if (m_savedActivationState != 0) {
+    obj->forceActivationState(m_savedActivationState);
+    m_savedActivationState = 0;
+  }
 }
 
 float CcdPhysicsController::GetLinearDamping() const
@@ -1934,6 +2117,7 @@ void CcdShapeConstructionInfo::ProcessReplica()
   m_userData = nullptr;
   m_meshObject = nullptr;
   m_triangleIndexVertexArray = nullptr;
+  m_optimizedBvh = nullptr;
   m_forceReInstance = false;
   m_shapeProxy = nullptr;
   m_vertexArray.clear();
@@ -2670,6 +2854,10 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin,
         if (!m_triangleIndexVertexArray || m_forceReInstance) {
           if (m_triangleIndexVertexArray)
             delete m_triangleIndexVertexArray;
+          if (m_optimizedBvh) {
+            CcdShapeCache::ReleaseBvh(m_optimizedBvh);
+            m_optimizedBvh = nullptr;
+          }
 
           m_triangleIndexVertexArray = new btTriangleIndexVertexArray(m_polygonIndexArray.size(),
                                                                       m_triFaceArray.data(),
@@ -2708,6 +2896,11 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin,
             if (m_triangleIndexVertexArray) {
               delete m_triangleIndexVertexArray;
             }
+            // The triangles could have changed, look up again the cooked BVH.
+            if (m_optimizedBvh) {
+              CcdShapeCache::ReleaseBvh(m_optimizedBvh);
+              m_optimizedBvh = nullptr;
+            }
             m_triangleIndexVertexArray = new btTriangleIndexVertexArray(m_polygonIndexArray.size(),
                                                                         m_triFaceArray.data(),
                                                                         3 * sizeof(int),
@@ -2719,8 +2912,21 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin,
           m_forceReInstance = false;
         }
 
+        // The BVH of unwelded triangles is shared between all the shapes of identical meshes
+        // and cached on disk.
+        const bool useCache = useBvh && (m_weldingThreshold1 == 0.0f);
         btBvhTriangleMeshShape *unscaledShape = new btBvhTriangleMeshShape(
-            m_triangleIndexVertexArray, true, useBvh);
+            m_triangleIndexVertexArray, true, useBvh && !useCache);
+        if (useCache) {
+          if (!m_optimizedBvh) {
+            const uint64_t hash = CcdShapeCache::ComputeHash(&m_vertexArray[0],
+                                                             m_vertexArray.size(),
+                                                             m_triFaceArray.data(),
+                                                             m_triFaceArray.size());
+            m_optimizedBvh = CcdShapeCache::GetBvh(unscaledShape, hash);
+          }
+          unscaledShape->setOptimizedBvh(m_optimizedBvh->GetBvh());
+        }
         unscaledShape->setMargin(margin);
         collisionShape = new btScaledBvhTriangleMeshShape(unscaledShape,
                                                           btVector3(1.0f, 1.0f, 1.0f));
@@ -2768,6 +2974,9 @@ CcdShapeConstructionInfo::~CcdShapeConstructionInfo()
 
   if (m_triangleIndexVertexArray)
     delete m_triangleIndexVertexArray;
+  if (m_optimizedBvh) {
+    CcdShapeCache::ReleaseBvh(m_optimizedBvh);
+  }
   m_vertexArray.clear();
   if (m_shapeType == PHY_SHAPE_MESH && m_meshObject != nullptr) {
     std::map<RAS_MeshObject *, CcdShapeConstructionInfo *>::iterator mit = m_meshShapeMap.find(
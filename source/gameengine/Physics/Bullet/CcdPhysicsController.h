@@ -47,6 +47,7 @@ class CcdPhysicsController;
 class btMotionState;
 class RAS_MeshObject;
 struct DerivedMesh;
+struct Mesh;
 class btCollisionShape;
 
 #define CCD_BSB_SHAPE_MATCHING 2
@@ -81,6 +82,7 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
         m_userData(nullptr),
         m_meshObject(nullptr),
         m_triangleIndexVertexArray(nullptr),
+        m_optimizedBvh(nullptr),
         m_forceReInstance(false),
         m_weldingThreshold1(0.0f),
         m_shapeProxy(nullptr)
@@ -195,6 +197,8 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
   RAS_MeshObject *m_meshObject;
   /// The list of vertexes and indexes for the triangle mesh, shared between Bullet shape.
   btTriangleIndexVertexArray *m_triangleIndexVertexArray;
+  /// The cooked BVH of the triangle mesh, shared with the shapes of identical meshes.
+  class CcdOptimizedBvh *m_optimizedBvh;
   /// for compound shapes
   std::vector<CcdShapeConstructionInfo *> m_shapeArray;
   /// use gimpact for concave dynamic/moving collision detection
@@ -266,6 +270,8 @@ struct CcdConstructionInfo {
         m_soft_kKHR(0.1f),
         m_soft_kSHR(1.0f),
         m_soft_kAHR(0.7f),
+        m_soft_collisionflags(0),
+        m_soft_numclusteriterations(0),
         m_collisionFlags(0),
         m_bDyna(false),
         m_bRigid(false),
@@ -456,6 +462,44 @@ class BlenderBulletCharacterController : public btKinematicCharacterController,
   unsigned char m_jumps;
   unsigned char m_maxJumps;
 
+ public:
+  /// Simulation state of the character not stored in its ghost object.
+  struct State {
+    btVector3 m_walkDirection;
+    btVector3 m_normalizedDirection;
+    btScalar m_verticalVelocity;
+    btScalar m_verticalOffset;
+    btScalar m_velocityTimeInterval;
+    bool m_wasOnGround;
+    bool m_wasJumping;
+    bool m_useWalkDirection;
+    unsigned char m_jumps;
+  };
+
+ private:
+  /** Inputs of the last step which left the character at rest. The step is a function of these
+   * inputs, while they don't change the next steps would do the same sweeps and ground probe
+   * to compute the same result, they are then skipped.
+   */
+  struct RestCache {
+    bool m_valid;
+    btScalar m_timeStep;
+    btScalar m_gravity;
+    btScalar m_maxSlopeCosine;
+    btScalar m_stepHeight;
+    btTransform m_transform;
+    State m_state;
+    /// Objects overlapping the ghost object and their transform.
+    std::vector<std::pair<const btCollisionObject *, btTransform>> m_overlaps;
+  };
+
+  RestCache m_restCache;
+
+  /// Return true if the inputs of a step are the ones of the cached rest step.
+  bool MatchRestCache(btScalar dt) const;
+  /// Store the inputs of a step if it didn't change the character state and transform.
+  void UpdateRestCache(btScalar dt, const State &prevState, const btTransform &prevTransform);
+
  public:
   BlenderBulletCharacterController(CcdPhysicsController *ctrl,
                                    btMotionState *motionState,
@@ -479,6 +523,9 @@ class BlenderBulletCharacterController : public btKinematicCharacterController,
 
   void SetVelocity(const btVector3 &vel, float time, bool local);
 
+  State GetState() const;
+  void SetState(const State &state);
+
   // PHY_ICharacter interface
   virtual void Jump()
   {
@@ -571,6 +618,15 @@ class CcdPhysicsController : public PHY_IPhysicsController {
   bool m_softBodyTransformInitialized;
   bool m_prototypeTransformInitialized;
   btTransform m_softbodyStartTrans;
+  /// Soft body node index of each mesh vertex, -1 for the vertices not simulated.
+  std::vector<int> m_softBodyVertexNodes;
+  /// Mesh of the vertex mapping, nullptr when the mapping must be rebuilt.
+  Mesh *m_softBodyVertexNodesMesh;
+  /// False if the mesh was not updated since the last soft body simulation.
+  bool m_softBodyMeshSynced;
+
+  /// Build the mapping of the mesh vertices to the soft body nodes.
+  void InitSoftBodyVertexNodes(RAS_MeshObject *rasMesh, Mesh *me);
 
   void *m_newClientInfo;
   int m_registerCount;        // needed when multiple sensors use the same controller
@@ -584,6 +640,8 @@ class CcdPhysicsController : public PHY_IPhysicsController {
   MT_Scalar m_savedMass;
   bool m_savedDyna;
   bool m_suspended;
+  /// Activation state before SetActive(false), 0 when the simulation is not disabled.
+  int m_savedActivationState;
 
   void GetWorldOrientation(btMatrix3x3 &mat);
 
@@ -666,6 +724,14 @@ class CcdPhysicsController : public PHY_IPhysicsController {
 
   virtual void UpdateSoftBody();
 
+  /** Return the mesh to update from the soft body nodes, nullptr if the soft body is asleep or
+   * invisible. The update is done by UpdateSoftBodyVertices and EndSoftBodyUpdate.
+   */
+  Mesh *BeginSoftBodyUpdate();
+  /// Copy the nodes to a range of the mesh vertices, thread safe.
+  void UpdateSoftBodyVertices(Mesh *me, int start, int end);
+  void EndSoftBodyUpdate(Mesh *me);
+
   /**
    * Called for every physics simulation step. Use this method for
    * things like limiting linear and angular velocity.
@@ -21,11 +21,15 @@
 
 #include "CcdPhysicsEnvironment.h"
 
+#include <type_traits>
 
 #include "BKE_object.h"
+#include "BLI_task.h"
+#include "DNA_mesh_types.h"
 #include "DNA_object_force_types.h"
 #include "DNA_scene_types.h"
 
+#include "BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
 #include "BulletDynamics/ConstraintSolver/btNNCGConstraintSolver.h"
 #include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
@@ -366,6 +370,101 @@ void CcdPhysicsEnvironment::SetDebugDrawer(btIDebugDraw *debugDrawer)
   m_debugDrawer = debugDrawer;
 }
 
+/// Exchange the two objects of a contact point.
+static void manifold_point_swap(btManifoldPoint &point)
+{
+  std::swap(point.m_localPointA, point.m_localPointB);
+  std::swap(point.m_positionWorldOnA, point.m_positionWorldOnB);
+  std::swap(point.m_partId0, point.m_partId1);
+  std::swap(point.m_index0, point.m_index1);
+  point.m_normalWorldOnB = -point.m_normalWorldOnB;
+  point.m_lateralFrictionDir1 = -point.m_lateralFrictionDir1;
+  point.m_lateralFrictionDir2 = -point.m_lateralFrictionDir2;
+}
+
+/// Dispatcher giving back the contact points of a restored state to the new manifolds.
+class CcdCollisionDispatcher : public btCollisionDispatcher {
+  /** Manifolds of the restored state not yet created again by the collision algorithms, the
+   * objects of a used manifold are cleared. */
+  btAlignedObjectArray<btPersistentManifold> m_restoredManifolds;
+
+ public:
+  CcdCollisionDispatcher(btCollisionConfiguration *collisionConfiguration)
+      : btCollisionDispatcher(collisionConfiguration)
+  {
+  }
+
+  const btAlignedObjectArray<btPersistentManifold> &GetRestoredManifolds() const
+  {
+    return m_restoredManifolds;
+  }
+
+  void AddRestoredManifold(const btPersistentManifold &manifold)
+  {
+    m_restoredManifolds.push_back(manifold);
+  }
+
+  void ClearRestoredManifolds()
+  {
+    m_restoredManifolds.clear();
+  }
+
+  virtual btPersistentManifold *getNewManifold(const btCollisionObject *b0,
+                                               const btCollisionObject *b1)
+  {
+    btPersistentManifold *manifold = btCollisionDispatcher::getNewManifold(b0, b1);
+
+    // The manifolds of a same pair of objects are given back in the saved order.
+    for (int i = 0, size = m_restoredManifolds.size(); i < size; ++i) {
+      btPersistentManifold &restored = m_restoredManifolds[i];
+      const bool swapped = (restored.getBody0() == b1 && restored.getBody1() == b0);
+      if (!swapped && (restored.getBody0() != b0 || restored.getBody1() != b1)) {
+        continue;
+      }
+
+      for (int j = 0, numContacts = restored.getNumContacts(); j < numContacts; ++j) {
+        btManifoldPoint point = restored.getContactPoint(j);
+        if (swapped) {
+          manifold_point_swap(point);
+        }
+        manifold->addManifoldPoint(point, true);
+      }
+      restored.setBodies(nullptr, nullptr);
+      break;
+    }
+
+    return manifold;
+  }
+};
+
+/// Dynamics world giving access to the time not simulated yet, part of the saved states.
+class CcdDynamicsWorld : public btSoftRigidDynamicsWorld {
+ public:
+  CcdDynamicsWorld(btDispatcher *dispatcher,
+                   btBroadphaseInterface *pairCache,
+                   btConstraintSolver *constraintSolver,
+                   btCollisionConfiguration *collisionConfiguration)
+      : btSoftRigidDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration)
+  {
+  }
+
+  btScalar GetLocalTime() const
+  {
+    return m_localTime;
+  }
+
+  void SetLocalTime(btScalar localTime)
+  {
+    m_localTime = localTime;
+  }
+
+  /// Release the contacts of the continuous collisions, they are predicted again at each step.
+  void ReleasePredictiveContacts()
+  {
+    releasePredictiveContacts();
+  }
+};
+
 CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType,
                                              bool useDbvtCulling)
     : m_cullingCache(nullptr),
@@ -389,7 +488,7 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType,
 
   m_collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
 
-  btCollisionDispatcher *dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
+  btCollisionDispatcher *dispatcher = new CcdCollisionDispatcher(m_collisionConfiguration);
   btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
   m_ownDispatcher = dispatcher;
 
@@ -408,7 +507,7 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType,
   SetSolverType(solverType);  // issues with quickstep and memory allocations
   //	m_dynamicsWorld = new
   // btDiscreteDynamicsWorld(dispatcher,m_broadphase,m_solver,m_collisionConfiguration);
-  m_dynamicsWorld = new btSoftRigidDynamicsWorld(
+  m_dynamicsWorld = new CcdDynamicsWorld(
       dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
   m_dynamicsWorld->setInternalTickCallback(&CcdPhysicsEnvironment::StaticSimulationSubtickCallback,
                                            this);
@@ -472,6 +571,14 @@ void CcdPhysicsEnvironment::AddCcdPhysicsController(CcdPhysicsController *ctrl)
     obj->setActivationState(ISLAND_SLEEPING);
   }
 
+  const CcdConstructionInfo &info = ctrl->GetConstructionInfo();
+  if (body && (info.m_do_fh || info.m_do_rot_fh)) {
+    m_fhControllers.push_back(ctrl);
+  }
+  if (ctrl->GetSoftBody()) {
+    m_softBodyControllers.push_back(ctrl);
+  }
+
   BLI_assert(obj->getBroadphaseHandle());
 }
 
@@ -559,6 +666,14 @@ void CcdPhysicsEnvironment::RestoreConstraint(CcdPhysicsController *ctrl, btType
   }
 }
 
+static void RemoveFromList(std::vector<CcdPhysicsController *> &list, CcdPhysicsController *ctrl)
+{
+  std::vector<CcdPhysicsController *>::iterator it = std::find(list.begin(), list.end(), ctrl);
+  if (it != list.end()) {
+    list.erase(it);
+  }
+}
+
 bool CcdPhysicsEnvironment::RemoveCcdPhysicsController(CcdPhysicsController *ctrl,
                                                        bool freeConstraints)
 {
@@ -567,6 +682,12 @@ bool CcdPhysicsEnvironment::RemoveCcdPhysicsController(CcdPhysicsController *ctr
     return false;
   }
 
+  RemoveFromList(m_fhControllers, ctrl);
+  RemoveFromList(m_softBodyControllers, ctrl);
+  // The contacts of a restored state could be given to a new object at the same address.
+  static_cast<CcdCollisionDispatcher *>(m_dynamicsWorld->getDispatcher())
+      ->ClearRestoredManifolds();
+
   // also remove constraint
   btRigidBody *body = ctrl->GetRigidBody();
   if (body) {
@@ -716,6 +837,10 @@ void CcdPhysicsEnvironment::SimulationSubtickCallback(btScalar timeStep)
 {
   std::set<CcdPhysicsController *>::iterator it;
 
+  // The manifolds of a restored state are created again during the first step or never.
+  static_cast<CcdCollisionDispatcher *>(m_dynamicsWorld->getDispatcher())
+      ->ClearRestoredManifolds();
+
   for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
     (*it)->SimulationTick(timeStep);
   }
@@ -761,12 +886,55 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
   return true;
 }
 
+/// Range of mesh vertices updated from a soft body.
+struct CcdSoftBodyVertexRange {
+  CcdPhysicsController *ctrl;
+  Mesh *mesh;
+  int start;
+  int end;
+};
+
+static void soft_body_vertices_task(void *__restrict userdata,
+                                    const int iter,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CcdSoftBodyVertexRange &range = (*(std::vector<CcdSoftBodyVertexRange> *)userdata)[iter];
+  range.ctrl->UpdateSoftBodyVertices(range.mesh, range.start, range.end);
+}
+
 void CcdPhysicsEnvironment::UpdateSoftBodies()
 {
-  std::set<CcdPhysicsController *>::iterator it;
+  if (m_softBodyControllers.empty()) {
+    return;
+  }
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    (*it)->UpdateSoftBody();
+  // Number of vertices copied by a task.
+  static const int rangeSize = 4096;
+
+  std::vector<std::pair<CcdPhysicsController *, Mesh *>> updates;
+  std::vector<CcdSoftBodyVertexRange> ranges;
+  std::set<Mesh *> meshes;
+  for (CcdPhysicsController *ctrl : m_softBodyControllers) {
+    Mesh *me = ctrl->BeginSoftBodyUpdate();
+    // Soft bodies sharing a mesh would write the same vertices concurrently.
+    if (!me || !meshes.insert(me).second) {
+      continue;
+    }
+
+    updates.emplace_back(ctrl, me);
+    for (int start = 0, totvert = me->totvert; start < totvert; start += rangeSize) {
+      ranges.push_back({ctrl, me, start, std::min(start + rangeSize, totvert)});
+    }
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (ranges.size() > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, ranges.size(), &ranges, soft_body_vertices_task, &settings);
+
+  for (const std::pair<CcdPhysicsController *, Mesh *> &update : updates) {
+    update.first->EndSoftBodyUpdate(update.second);
   }
 }
 
@@ -798,130 +966,285 @@ class ClosestRayResultCallbackNotMe : public btCollisionWorld::ClosestRayResultC
   }
 };
 
+/// Fh spring ray of a controller, the rays of all the controllers are cast in a batch.
+struct CcdFhRay {
+  CcdPhysicsController *m_ctrl;
+  /// The body receiving the spring forces, the parent of compound children.
+  btRigidBody *m_object;
+  ClosestRayResultCallbackNotMe m_result;
+  /// The ray hits an object which can't be ray cast concurrently, cast it on the main thread.
+  bool m_deferred;
+};
+
+/// Broadphase ray callback of a Fh ray, thread safe unlike btCollisionWorld::rayTest.
+class CcdFhRayCallback : public btBroadphaseRayCallback {
+ private:
+  btTransform m_rayFromTrans;
+  btTransform m_rayToTrans;
+  ClosestRayResultCallbackNotMe &m_resultCallback;
+
+ public:
+  bool m_deferred;
+
+  CcdFhRayCallback(ClosestRayResultCallbackNotMe &resultCallback)
+      : m_rayFromTrans(btMatrix3x3::getIdentity(), resultCallback.m_rayFromWorld),
+        m_rayToTrans(btMatrix3x3::getIdentity(), resultCallback.m_rayToWorld),
+        m_resultCallback(resultCallback),
+        m_deferred(false)
+  {
+    const btVector3 rayDir = (resultCallback.m_rayToWorld - resultCallback.m_rayFromWorld);
+    const btVector3 rayDirNormalized = rayDir.normalized();
+    for (unsigned short i = 0; i < 3; ++i) {
+      m_rayDirectionInverse[i] = (rayDirNormalized[i] == 0.0f) ? btScalar(BT_LARGE_FLOAT) :
+                                                                 1.0f / rayDirNormalized[i];
+      m_signs[i] = (m_rayDirectionInverse[i] < 0.0f);
+    }
+    m_lambda_max = rayDirNormalized.dot(rayDir);
+  }
+
+  virtual bool process(const btBroadphaseProxy *proxy)
+  {
+    if (m_resultCallback.m_closestHitFraction == 0.0f || m_deferred) {
+      return false;
+    }
+
+    btCollisionObject *object = (btCollisionObject *)proxy->m_clientObject;
+    if (!m_resultCallback.needsCollision(object->getBroadphaseHandle())) {
+      return true;
+    }
+
+    if (NeedsSerialRayTest(object->getCollisionShape())) {
+      m_deferred = true;
+      return false;
+    }
+
+    btCollisionWorld::rayTestSingle(m_rayFromTrans,
+                                    m_rayToTrans,
+                                    object,
+                                    object->getCollisionShape(),
+                                    object->getWorldTransform(),
+                                    m_resultCallback);
+    return true;
+  }
+
+  /** Return true if the ray test of the shape must not run concurrently: GImpact shapes lock
+   * their children, also inside compounds, and soft bodies are cast by the soft world.
+   */
+  static bool NeedsSerialRayTest(const btCollisionShape *shape)
+  {
+    switch (shape->getShapeType()) {
+      case GIMPACT_SHAPE_PROXYTYPE:
+      case SOFTBODY_SHAPE_PROXYTYPE: {
+        return true;
+      }
+      case COMPOUND_SHAPE_PROXYTYPE: {
+        const btCompoundShape *compound = static_cast<const btCompoundShape *>(shape);
+        for (int i = 0, size = compound->getNumChildShapes(); i < size; ++i) {
+          if (NeedsSerialRayTest(compound->getChildShape(i))) {
+            return true;
+          }
+        }
+        return false;
+      }
+      default: {
+        return false;
+      }
+    }
+  }
+};
+
+/// Calls the ray callback for the broadphase tree leaves hit.
+struct CcdFhRayTester : btDbvt::ICollide {
+  btBroadphaseRayCallback &m_rayCallback;
+
+  CcdFhRayTester(btBroadphaseRayCallback &rayCallback) : m_rayCallback(rayCallback)
+  {
+  }
+
+  void Process(const btDbvtNode *leaf)
+  {
+    m_rayCallback.process((btBroadphaseProxy *)leaf->data);
+  }
+};
+
+struct CcdFhRayTaskData {
+  std::vector<CcdFhRay> *rays;
+  btDbvtBroadphase *broadphase;
+};
+
+static void fh_ray_task(void *__restrict userdata,
+                        const int iter,
+                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CcdFhRayTaskData *data = (CcdFhRayTaskData *)userdata;
+  CcdFhRay &ray = (*data->rays)[iter];
+
+  CcdFhRayCallback callback(ray.m_result);
+  CcdFhRayTester tester(callback);
+  // Each ray uses its own stack, the broadphase one is shared.
+  btAlignedObjectArray<const btDbvtNode *> stack;
+  const btVector3 aabb(0.0f, 0.0f, 0.0f);
+
+  for (const btDbvt &set : data->broadphase->m_sets) {
+    set.rayTestInternal(set.m_root,
+                        ray.m_result.m_rayFromWorld,
+                        ray.m_result.m_rayToWorld,
+                        callback.m_rayDirectionInverse,
+                        callback.m_signs,
+                        callback.m_lambda_max,
+                        aabb,
+                        aabb,
+                        stack,
+                        tester);
+  }
+
+  ray.m_deferred = callback.m_deferred;
+}
+
 void CcdPhysicsEnvironment::ProcessFhSprings(double curTime, float interval)
 {
-  std::set<CcdPhysicsController *>::iterator it;
+  if (m_fhControllers.empty()) {
+    return;
+  }
 
   const float step = interval * KX_GetActiveEngine()->GetTicRate();
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    CcdPhysicsController *ctrl = (*it);
+  // re-implement SM_FhObject.cpp using ray tests and info from ctrl->getConstructionInfo()
+  // send a ray from the center of mass towards {0.0, 0.0, -10.0}, the ray always points down
+  // the z axis in world space.
+  const btVector3 rayDirLocal(0.0f, 0.0f, -10.0f);
+
+  std::vector<CcdFhRay> rays;
+  rays.reserve(m_fhControllers.size());
+  for (CcdPhysicsController *ctrl : m_fhControllers) {
     btRigidBody *body = ctrl->GetRigidBody();
+    if (!body || body->isStaticOrKinematicObject()) {
+      continue;
+    }
 
-    if (body && (ctrl->GetConstructionInfo().m_do_fh || ctrl->GetConstructionInfo().m_do_rot_fh)) {
-      // re-implement SM_FhObject.cpp using btCollisionWorld::rayTest and info from
-      // ctrl->getConstructionInfo() send a ray from {0.0, 0.0, 0.0} towards {0.0, 0.0, -10.0}, in
-      // local coordinates
-      CcdPhysicsController *parentCtrl = ctrl->GetParentCtrl();
-      btRigidBody *parentBody = parentCtrl ? parentCtrl->GetRigidBody() : nullptr;
-      btRigidBody *cl_object = parentBody ? parentBody : body;
+    CcdPhysicsController *parentCtrl = ctrl->GetParentCtrl();
+    btRigidBody *parentBody = parentCtrl ? parentCtrl->GetRigidBody() : nullptr;
+    const btVector3 rayFromWorld = body->getCenterOfMassPosition();
+    const btVector3 rayToWorld = rayFromWorld + rayDirLocal;
+
+    rays.push_back({ctrl,
+                    parentBody ? parentBody : body,
+                    ClosestRayResultCallbackNotMe(rayFromWorld, rayToWorld, body, parentBody),
+                    false});
+  }
+
+  /* The rays only read the collision world, they are all cast before applying the springs.
+   * Small batches are not worth the threads overhead. */
+  CcdFhRayTaskData data = {&rays, static_cast<btDbvtBroadphase *>(m_broadphase)};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (rays.size() > 64);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, rays.size(), &data, fh_ray_task, &settings);
+
+  for (CcdFhRay &ray : rays) {
+    CcdPhysicsController *ctrl = ray.m_ctrl;
+    btRigidBody *cl_object = ray.m_object;
+    ClosestRayResultCallbackNotMe &result = ray.m_result;
+
+    if (ray.m_deferred) {
+      result.m_closestHitFraction = 1.0f;
+      result.m_collisionObject = nullptr;
+      m_dynamicsWorld->rayTest(result.m_rayFromWorld, result.m_rayToWorld, result);
+    }
 
-      if (body->isStaticOrKinematicObject())
-        continue;
+    if (!result.hasHit()) {
+      continue;
+    }
 
-      btVector3 rayDirLocal(0.0f, 0.0f, -10.0f);
-
-      // m_dynamicsWorld
-      // ctrl->GetRigidBody();
-      btVector3 rayFromWorld = body->getCenterOfMassPosition();
-      // btVector3	rayToWorld = rayFromWorld + body->getCenterOfMassTransform().getBasis() *
-      // rayDirLocal; ray always points down the z axis in world space...
-      btVector3 rayToWorld = rayFromWorld + rayDirLocal;
-
-      ClosestRayResultCallbackNotMe resultCallback(rayFromWorld, rayToWorld, body, parentBody);
-
-      m_dynamicsWorld->rayTest(rayFromWorld, rayToWorld, resultCallback);
-      if (resultCallback.hasHit()) {
-        // we hit this one: resultCallback.m_collisionObject;
-        CcdPhysicsController *controller = static_cast<CcdPhysicsController *>(
-            resultCallback.m_collisionObject->getUserPointer());
-
-        if (controller) {
-          if (controller->GetConstructionInfo().m_fh_distance < SIMD_EPSILON)
-            continue;
-
-          btRigidBody *hit_object = controller->GetRigidBody();
-          if (!hit_object)
-            continue;
-
-          CcdConstructionInfo &hitObjShapeProps = controller->GetConstructionInfo();
-
-          float distance = resultCallback.m_closestHitFraction * rayDirLocal.length() -
-                           ctrl->GetConstructionInfo().m_radius;
-          if (distance >= hitObjShapeProps.m_fh_distance)
-            continue;
-
-          // btVector3 ray_dir = cl_object->getCenterOfMassTransform().getBasis()*
-          // rayDirLocal.normalized();
-          btVector3 ray_dir = rayDirLocal.normalized();
-          btVector3 normal = resultCallback.m_hitNormalWorld;
-          normal.normalize();
-
-          if (ctrl->GetConstructionInfo().m_do_fh) {
-            btVector3 lspot = cl_object->getCenterOfMassPosition() +
-                              rayDirLocal * resultCallback.m_closestHitFraction;
-
-            lspot -= hit_object->getCenterOfMassPosition();
-            btVector3 rel_vel = cl_object->getLinearVelocity() -
-                                hit_object->getVelocityInLocalPoint(lspot);
-            btScalar rel_vel_ray = ray_dir.dot(rel_vel);
-            btScalar spring_extent = 1.0f - distance / hitObjShapeProps.m_fh_distance;
-
-            btScalar i_spring = spring_extent * hitObjShapeProps.m_fh_spring;
-            btScalar i_damp = rel_vel_ray * hitObjShapeProps.m_fh_damping;
-
-            cl_object->setLinearVelocity(cl_object->getLinearVelocity() +
-                                         (-(i_spring + i_damp) * ray_dir) * step);
-            if (hitObjShapeProps.m_fh_normal) {
-              cl_object->setLinearVelocity(cl_object->getLinearVelocity() +
-                                           (i_spring + i_damp) *
-                                               (normal - normal.dot(ray_dir) * ray_dir) * step);
-            }
+    // we hit this one: result.m_collisionObject;
+    CcdPhysicsController *controller = static_cast<CcdPhysicsController *>(
+        result.m_collisionObject->getUserPointer());
 
-            btVector3 lateral = rel_vel - rel_vel_ray * ray_dir;
+    if (controller) {
+      if (controller->GetConstructionInfo().m_fh_distance < SIMD_EPSILON)
+        continue;
 
-            if (ctrl->GetConstructionInfo().m_do_anisotropic) {
-              // Bullet basis contains no scaling/shear etc.
-              const btMatrix3x3 &lcs = cl_object->getCenterOfMassTransform().getBasis();
-              btVector3 loc_lateral = lateral * lcs;
-              const btVector3 &friction_scaling = cl_object->getAnisotropicFriction();
-              loc_lateral *= friction_scaling;
-              lateral = lcs * loc_lateral;
-            }
+      btRigidBody *hit_object = controller->GetRigidBody();
+      if (!hit_object)
+        continue;
 
-            btScalar rel_vel_lateral = lateral.length();
+      CcdConstructionInfo &hitObjShapeProps = controller->GetConstructionInfo();
 
-            if (rel_vel_lateral > SIMD_EPSILON) {
-              btScalar friction_factor = hit_object->getFriction();  // cl_object->getFriction();
+      float distance = result.m_closestHitFraction * rayDirLocal.length() -
+                       ctrl->GetConstructionInfo().m_radius;
+      if (distance >= hitObjShapeProps.m_fh_distance)
+        continue;
 
-              btScalar max_friction = friction_factor * btMax(btScalar(0.0), i_spring);
+      // btVector3 ray_dir = cl_object->getCenterOfMassTransform().getBasis()*
+      // rayDirLocal.normalized();
+      btVector3 ray_dir = rayDirLocal.normalized();
+      btVector3 normal = result.m_hitNormalWorld;
+      normal.normalize();
+
+      if (ctrl->GetConstructionInfo().m_do_fh) {
+        btVector3 lspot = cl_object->getCenterOfMassPosition() +
+                          rayDirLocal * result.m_closestHitFraction;
+
+        lspot -= hit_object->getCenterOfMassPosition();
+        btVector3 rel_vel = cl_object->getLinearVelocity() -
+                            hit_object->getVelocityInLocalPoint(lspot);
+        btScalar rel_vel_ray = ray_dir.dot(rel_vel);
+        btScalar spring_extent = 1.0f - distance / hitObjShapeProps.m_fh_distance;
+
+        btScalar i_spring = spring_extent * hitObjShapeProps.m_fh_spring;
+        btScalar i_damp = rel_vel_ray * hitObjShapeProps.m_fh_damping;
+
+        cl_object->setLinearVelocity(cl_object->getLinearVelocity() +
+                                     (-(i_spring + i_damp) * ray_dir) * step);
+        if (hitObjShapeProps.m_fh_normal) {
+          cl_object->setLinearVelocity(cl_object->getLinearVelocity() +
+                                       (i_spring + i_damp) *
+                                           (normal - normal.dot(ray_dir) * ray_dir) * step);
+        }
 
-              btScalar rel_mom_lateral = rel_vel_lateral / cl_object->getInvMass();
+        btVector3 lateral = rel_vel - rel_vel_ray * ray_dir;
 
-              btVector3 friction = (rel_mom_lateral > max_friction) ?
-                                       -lateral * (max_friction / rel_vel_lateral) :
-                                       -lateral;
+        if (ctrl->GetConstructionInfo().m_do_anisotropic) {
+          // Bullet basis contains no scaling/shear etc.
+          const btMatrix3x3 &lcs = cl_object->getCenterOfMassTransform().getBasis();
+          btVector3 loc_lateral = lateral * lcs;
+          const btVector3 &friction_scaling = cl_object->getAnisotropicFriction();
+          loc_lateral *= friction_scaling;
+          lateral = lcs * loc_lateral;
+        }
 
-              cl_object->applyCentralImpulse(friction * step);
-            }
-          }
+        btScalar rel_vel_lateral = lateral.length();
 
-          if (ctrl->GetConstructionInfo().m_do_rot_fh) {
-            btVector3 up2 = cl_object->getWorldTransform().getBasis().getColumn(2);
+        if (rel_vel_lateral > SIMD_EPSILON) {
+          btScalar friction_factor = hit_object->getFriction();  // cl_object->getFriction();
 
-            btVector3 t_spring = up2.cross(normal) * hitObjShapeProps.m_fh_spring;
-            btVector3 ang_vel = cl_object->getAngularVelocity();
+          btScalar max_friction = friction_factor * btMax(btScalar(0.0), i_spring);
 
-            // only rotations that tilt relative to the normal are damped
-            ang_vel -= ang_vel.dot(normal) * normal;
+          btScalar rel_mom_lateral = rel_vel_lateral / cl_object->getInvMass();
 
-            btVector3 t_damp = ang_vel * hitObjShapeProps.m_fh_damping;
+          btVector3 friction = (rel_mom_lateral > max_friction) ?
+                                   -lateral * (max_friction / rel_vel_lateral) :
+                                   -lateral;
 
-            cl_object->setAngularVelocity(cl_object->getAngularVelocity() +
-                                          (t_spring - t_damp) * step);
-          }
+          cl_object->applyCentralImpulse(friction * step);
         }
       }
+
+      if (ctrl->GetConstructionInfo().m_do_rot_fh) {
+        btVector3 up2 = cl_object->getWorldTransform().getBasis().getColumn(2);
+
+        btVector3 t_spring = up2.cross(normal) * hitObjShapeProps.m_fh_spring;
+        btVector3 ang_vel = cl_object->getAngularVelocity();
+
+        // only rotations that tilt relative to the normal are damped
+        ang_vel -= ang_vel.dot(normal) * normal;
+
+        btVector3 t_damp = ang_vel * hitObjShapeProps.m_fh_damping;
+
+        cl_object->setAngularVelocity(cl_object->getAngularVelocity() +
+                                      (t_spring - t_damp) * step);
+      }
     }
   }
 }
@@ -1989,6 +2312,696 @@ void CcdPhysicsEnvironment::MergeEnvironment(PHY_IPhysicsEnvironment *other_env)
   }
 }
 
+/// Bump when the layout of the saved states changes.
+static const uint32_t stateVersion = 3;
+
+/* The states are written field by field, only scalars are copied as is, so that the buffer
+ * never contains the padding or the SIMD lanes of the Bullet structures. */
+template <class T> static void state_write(std::vector<unsigned char> &buffer, T value)
+{
+  static_assert(std::is_arithmetic<T>::value, "write the fields of compound types");
+  const unsigned char *data = (const unsigned char *)&value;
+  buffer.insert(buffer.end(), data, data + sizeof(T));
+}
+
+template <class T>
+static bool state_read(const std::vector<unsigned char> &buffer, size_t &offset, T &value)
+{
+  static_assert(std::is_arithmetic<T>::value, "read the fields of compound types");
+  if (offset + sizeof(T) > buffer.size()) {
+    return false;
+  }
+  memcpy(&value, buffer.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return true;
+}
+
+static void state_write(std::vector<unsigned char> &buffer, bool value)
+{
+  state_write(buffer, (uint8_t)value);
+}
+
+static bool state_read(const std::vector<unsigned char> &buffer, size_t &offset, bool &value)
+{
+  uint8_t byte;
+  if (!state_read(buffer, offset, byte) || byte > 1) {
+    return false;
+  }
+  value = (byte == 1);
+  return true;
+}
+
+static void state_write(std::vector<unsigned char> &buffer, const btVector3 &vector)
+{
+  for (unsigned short i = 0; i < 3; ++i) {
+    state_write(buffer, vector[i]);
+  }
+}
+
+static bool state_read(const std::vector<unsigned char> &buffer, size_t &offset, btVector3 &vector)
+{
+  btScalar x, y, z;
+  if (!state_read(buffer, offset, x) || !state_read(buffer, offset, y) ||
+      !state_read(buffer, offset, z)) {
+    return false;
+  }
+  vector.setValue(x, y, z);
+  return true;
+}
+
+static void state_write(std::vector<unsigned char> &buffer, const btMatrix3x3 &matrix)
+{
+  for (unsigned short i = 0; i < 3; ++i) {
+    state_write(buffer, matrix[i]);
+  }
+}
+
+static bool state_read(const std::vector<unsigned char> &buffer,
+                       size_t &offset,
+                       btMatrix3x3 &matrix)
+{
+  btVector3 rows[3];
+  if (!state_read(buffer, offset, rows[0]) || !state_read(buffer, offset, rows[1]) ||
+      !state_read(buffer, offset, rows[2])) {
+    return false;
+  }
+  matrix.setValue(rows[0][0],
+                  rows[0][1],
+                  rows[0][2],
+                  rows[1][0],
+                  rows[1][1],
+                  rows[1][2],
+                  rows[2][0],
+                  rows[2][1],
+                  rows[2][2]);
+  return true;
+}
+
+static void state_write(std::vector<unsigned char> &buffer, const btTransform &transform)
+{
+  state_write(buffer, transform.getBasis());
+  state_write(buffer, transform.getOrigin());
+}
+
+static bool state_read(const std::vector<unsigned char> &buffer,
+                       size_t &offset,
+                       btTransform &transform)
+{
+  return (state_read(buffer, offset, transform.getBasis()) &&
+          state_read(buffer, offset, transform.getOrigin()));
+}
+
+/// Write a contact point with the impulses used to warm start the solver.
+static void state_write(std::vector<unsigned char> &buffer, const btManifoldPoint &point)
+{
+  state_write(buffer, point.m_localPointA);
+  state_write(buffer, point.m_localPointB);
+  state_write(buffer, point.m_positionWorldOnB);
+  state_write(buffer, point.m_positionWorldOnA);
+  state_write(buffer, point.m_normalWorldOnB);
+  state_write(buffer, point.m_distance1);
+  state_write(buffer, point.m_combinedFriction);
+  state_write(buffer, point.m_combinedRollingFriction);
+  state_write(buffer, point.m_combinedSpinningFriction);
+  state_write(buffer, point.m_combinedRestitution);
+  state_write(buffer, (int32_t)point.m_partId0);
+  state_write(buffer, (int32_t)point.m_partId1);
+  state_write(buffer, (int32_t)point.m_index0);
+  state_write(buffer, (int32_t)point.m_index1);
+  state_write(buffer, (int32_t)point.m_contactPointFlags);
+  state_write(buffer, point.m_appliedImpulse);
+  state_write(buffer, point.m_prevRHS);
+  state_write(buffer, point.m_appliedImpulseLateral1);
+  state_write(buffer, point.m_appliedImpulseLateral2);
+  state_write(buffer, point.m_contactMotion1);
+  state_write(buffer, point.m_contactMotion2);
+  state_write(buffer, point.m_contactCFM);
+  state_write(buffer, point.m_contactERP);
+  state_write(buffer, point.m_frictionCFM);
+  state_write(buffer, (int32_t)point.m_lifeTime);
+  state_write(buffer, point.m_lateralFrictionDir1);
+  state_write(buffer, point.m_lateralFrictionDir2);
+}
+
+static bool state_read(const std::vector<unsigned char> &buffer,
+                       size_t &offset,
+                       btManifoldPoint &point)
+{
+  int32_t partId0, partId1, index0, index1, flags, lifeTime;
+  if (!state_read(buffer, offset, point.m_localPointA) ||
+      !state_read(buffer, offset, point.m_localPointB) ||
+      !state_read(buffer, offset, point.m_positionWorldOnB) ||
+      !state_read(buffer, offset, point.m_positionWorldOnA) ||
+      !state_read(buffer, offset, point.m_normalWorldOnB) ||
+      !state_read(buffer, offset, point.m_distance1) ||
+      !state_read(buffer, offset, point.m_combinedFriction) ||
+      !state_read(buffer, offset, point.m_combinedRollingFriction) ||
+      !state_read(buffer, offset, point.m_combinedSpinningFriction) ||
+      !state_read(buffer, offset, point.m_combinedRestitution) ||
+      !state_read(buffer, offset, partId0) || !state_read(buffer, offset, partId1) ||
+      !state_read(buffer, offset, index0) || !state_read(buffer, offset, index1) ||
+      !state_read(buffer, offset, flags) || !state_read(buffer, offset, point.m_appliedImpulse) ||
+      !state_read(buffer, offset, point.m_prevRHS) ||
+      !state_read(buffer, offset, point.m_appliedImpulseLateral1) ||
+      !state_read(buffer, offset, point.m_appliedImpulseLateral2) ||
+      !state_read(buffer, offset, point.m_contactMotion1) ||
+      !state_read(buffer, offset, point.m_contactMotion2) ||
+      !state_read(buffer, offset, point.m_contactCFM) ||
+      !state_read(buffer, offset, point.m_contactERP) ||
+      !state_read(buffer, offset, point.m_frictionCFM) ||
+      !state_read(buffer, offset, lifeTime) ||
+      !state_read(buffer, offset, point.m_lateralFrictionDir1) ||
+      !state_read(buffer, offset, point.m_lateralFrictionDir2)) {
+    return false;
+  }
+  point.m_partId0 = partId0;
+  point.m_partId1 = partId1;
+  point.m_index0 = index0;
+  point.m_index1 = index1;
+  point.m_contactPointFlags = flags;
+  point.m_lifeTime = lifeTime;
+  point.m_userPersistentData = nullptr;
+  return true;
+}
+
+/// Write the values of a soft body changed by the steps and by the motion state synchronization.
+static void state_write(std::vector<unsigned char> &buffer, const btSoftBody &softBody)
+{
+  state_write(buffer, (int32_t)softBody.m_nodes.size());
+  for (int i = 0, size = softBody.m_nodes.size(); i < size; ++i) {
+    const btSoftBody::Node &node = softBody.m_nodes[i];
+    state_write(buffer, node.m_x);
+    state_write(buffer, node.m_v);
+    state_write(buffer, node.m_f);
+    state_write(buffer, node.m_n);
+    state_write(buffer, node.m_area);
+  }
+  state_write(buffer, (int32_t)softBody.m_links.size());
+  for (int i = 0, size = softBody.m_links.size(); i < size; ++i) {
+    const btSoftBody::Link &link = softBody.m_links[i];
+    state_write(buffer, link.m_rl);
+    state_write(buffer, link.m_c1);
+  }
+  state_write(buffer, (int32_t)softBody.m_faces.size());
+  for (int i = 0, size = softBody.m_faces.size(); i < size; ++i) {
+    const btSoftBody::Face &face = softBody.m_faces[i];
+    state_write(buffer, face.m_normal);
+    state_write(buffer, face.m_ra);
+  }
+  state_write(buffer, softBody.m_bounds[0]);
+  state_write(buffer, softBody.m_bounds[1]);
+  state_write(buffer, softBody.m_pose.m_com);
+  state_write(buffer, softBody.m_pose.m_rot);
+  state_write(buffer, softBody.m_pose.m_scl);
+  state_write(buffer, softBody.m_bUpdateRtCst);
+}
+
+/// Read the state of a soft body, the soft body is only modified when apply is true.
+static bool state_read(const std::vector<unsigned char> &buffer,
+                       size_t &offset,
+                       btSoftBody &softBody,
+                       bool apply)
+{
+  int32_t numNodes;
+  if (!state_read(buffer, offset, numNodes) || numNodes != softBody.m_nodes.size()) {
+    return false;
+  }
+  for (int i = 0; i < numNodes; ++i) {
+    btSoftBody::Node node = softBody.m_nodes[i];
+    if (!state_read(buffer, offset, node.m_x) || !state_read(buffer, offset, node.m_v) ||
+        !state_read(buffer, offset, node.m_f) || !state_read(buffer, offset, node.m_n) ||
+        !state_read(buffer, offset, node.m_area)) {
+      return false;
+    }
+    if (apply) {
+      softBody.m_nodes[i] = node;
+    }
+  }
+
+  int32_t numLinks;
+  if (!state_read(buffer, offset, numLinks) || numLinks != softBody.m_links.size()) {
+    return false;
+  }
+  for (int i = 0; i < numLinks; ++i) {
+    btScalar restLength, squaredRestLength;
+    if (!state_read(buffer, offset, restLength) ||
+        !state_read(buffer, offset, squaredRestLength)) {
+      return false;
+    }
+    if (apply) {
+      softBody.m_links[i].m_rl = restLength;
+      softBody.m_links[i].m_c1 = squaredRestLength;
+    }
+  }
+
+  int32_t numFaces;
+  if (!state_read(buffer, offset, numFaces) || numFaces != softBody.m_faces.size()) {
+    return false;
+  }
+  for (int i = 0; i < numFaces; ++i) {
+    btVector3 normal;
+    btScalar area;
+    if (!state_read(buffer, offset, normal) || !state_read(buffer, offset, area)) {
+      return false;
+    }
+    if (apply) {
+      softBody.m_faces[i].m_normal = normal;
+      softBody.m_faces[i].m_ra = area;
+    }
+  }
+
+  btVector3 bounds[2];
+  btVector3 poseCom;
+  btMatrix3x3 poseRot, poseScale;
+  bool updateConstants;
+  if (!state_read(buffer, offset, bounds[0]) || !state_read(buffer, offset, bounds[1]) ||
+      !state_read(buffer, offset, poseCom) || !state_read(buffer, offset, poseRot) ||
+      !state_read(buffer, offset, poseScale) || !state_read(buffer, offset, updateConstants)) {
+    return false;
+  }
+  if (apply) {
+    softBody.m_bounds[0] = bounds[0];
+    softBody.m_bounds[1] = bounds[1];
+    softBody.m_pose.m_com = poseCom;
+    softBody.m_pose.m_rot = poseRot;
+    softBody.m_pose.m_scl = poseScale;
+    softBody.m_bUpdateRtCst = updateConstants;
+  }
+  return true;
+}
+
+static void state_write(std::vector<unsigned char> &buffer,
+                        const BlenderBulletCharacterController::State &state)
+{
+  state_write(buffer, state.m_walkDirection);
+  state_write(buffer, state.m_normalizedDirection);
+  state_write(buffer, state.m_verticalVelocity);
+  state_write(buffer, state.m_verticalOffset);
+  state_write(buffer, state.m_velocityTimeInterval);
+  state_write(buffer, state.m_wasOnGround);
+  state_write(buffer, state.m_wasJumping);
+  state_write(buffer, state.m_useWalkDirection);
+  state_write(buffer, state.m_jumps);
+}
+
+static bool state_read(const std::vector<unsigned char> &buffer,
+                       size_t &offset,
+                       BlenderBulletCharacterController::State &state)
+{
+  return (state_read(buffer, offset, state.m_walkDirection) &&
+          state_read(buffer, offset, state.m_normalizedDirection) &&
+          state_read(buffer, offset, state.m_verticalVelocity) &&
+          state_read(buffer, offset, state.m_verticalOffset) &&
+          state_read(buffer, offset, state.m_velocityTimeInterval) &&
+          state_read(buffer, offset, state.m_wasOnGround) &&
+          state_read(buffer, offset, state.m_wasJumping) &&
+          state_read(buffer, offset, state.m_useWalkDirection) &&
+          state_read(buffer, offset, state.m_jumps));
+}
+
+bool CcdPhysicsEnvironment::SaveState(std::vector<unsigned char> &buffer)
+{
+  CcdDynamicsWorld *world = static_cast<CcdDynamicsWorld *>(m_dynamicsWorld);
+  // Only the contacts of the pairs are kept between the steps.
+  world->ReleasePredictiveContacts();
+
+  buffer.clear();
+
+  state_write(buffer, stateVersion);
+  state_write(buffer, (uint8_t)sizeof(btScalar));
+  state_write(buffer, world->GetLocalTime());
+  // The seed used by the solver to shuffle the constraints.
+  state_write(
+      buffer,
+      (uint64_t) static_cast<btSequentialImpulseConstraintSolver *>(m_solver)->getRandSeed());
+
+  /* The controllers are identified by their address, the set order is the same as long as
+   * the environment contains the same controllers. */
+  state_write(buffer, (uint32_t)m_controllers.size());
+  for (CcdPhysicsController *ctrl : m_controllers) {
+    state_write(buffer, (uint64_t)(uintptr_t)ctrl);
+
+    const btCollisionObject *object = ctrl->GetCollisionObject();
+    state_write(buffer, object->getWorldTransform());
+    state_write(buffer, object->getInterpolationWorldTransform());
+    state_write(buffer, object->getInterpolationLinearVelocity());
+    state_write(buffer, object->getInterpolationAngularVelocity());
+    state_write(buffer, (int32_t)object->getActivationState());
+    state_write(buffer, object->getDeactivationTime());
+    state_write(buffer, object->getHitFraction());
+
+    const btRigidBody *body = ctrl->GetRigidBody();
+    if (body) {
+      state_write(buffer, body->getLinearVelocity());
+      state_write(buffer, body->getAngularVelocity());
+      state_write(buffer, body->getTotalForce());
+      state_write(buffer, body->getTotalTorque());
+    }
+
+    BlenderBulletCharacterController *character = static_cast<BlenderBulletCharacterController *>(
+        ctrl->GetCharacterController());
+    if (character) {
+      state_write(buffer, character->GetState());
+    }
+
+    const btSoftBody *softBody = ctrl->GetSoftBody();
+    if (softBody) {
+      state_write(buffer, *softBody);
+    }
+  }
+
+  /* The objects of the contacts are identified by their index in the world, the world must
+   * contain the same objects in the same order. */
+  const btCollisionObjectArray &objects = m_dynamicsWorld->getCollisionObjectArray();
+  state_write(buffer, (int32_t)objects.size());
+  for (int i = 0, size = objects.size(); i < size; ++i) {
+    state_write(buffer, (uint64_t)(uintptr_t)objects[i]->getUserPointer());
+  }
+
+  // The manifolds of a restored state not created again yet are part of the state.
+  CcdCollisionDispatcher *dispatcher = static_cast<CcdCollisionDispatcher *>(
+      m_dynamicsWorld->getDispatcher());
+  std::vector<const btPersistentManifold *> manifolds;
+  for (int i = 0, size = dispatcher->getNumManifolds(); i < size; ++i) {
+    manifolds.push_back(dispatcher->getManifoldByIndexInternal(i));
+  }
+  const btAlignedObjectArray<btPersistentManifold> &restoredManifolds =
+      dispatcher->GetRestoredManifolds();
+  for (int i = 0, size = restoredManifolds.size(); i < size; ++i) {
+    if (restoredManifolds[i].getBody0()) {
+      manifolds.push_back(&restoredManifolds[i]);
+    }
+  }
+
+  state_write(buffer, (int32_t)manifolds.size());
+  for (const btPersistentManifold *manifold : manifolds) {
+    state_write(buffer, (int32_t)manifold->getBody0()->getWorldArrayIndex());
+    state_write(buffer, (int32_t)manifold->getBody1()->getWorldArrayIndex());
+    const int numContacts = manifold->getNumContacts();
+    state_write(buffer, (int32_t)numContacts);
+    for (int j = 0; j < numContacts; ++j) {
+      state_write(buffer, manifold->getContactPoint(j));
+    }
+  }
+
+  const int numConstraints = m_dynamicsWorld->getNumConstraints();
+  state_write(buffer, (int32_t)numConstraints);
+  for (int i = 0; i < numConstraints; ++i) {
+    btTypedConstraint *con = m_dynamicsWorld->getConstraint(i);
+    state_write(buffer, (int32_t)con->getUserConstraintId());
+    state_write(buffer, con->isEnabled());
+    state_write(buffer, con->internalGetAppliedImpulse());
+  }
+
+  state_write(buffer, (uint32_t)m_wrapperVehicles.size());
+  for (WrapperVehicle *wrapper : m_wrapperVehicles) {
+    const btRaycastVehicle *vehicle = wrapper->GetVehicle();
+    const int numWheels = vehicle->getNumWheels();
+    state_write(buffer, (int32_t)numWheels);
+    for (int i = 0; i < numWheels; ++i) {
+      const btWheelInfo &info = vehicle->getWheelInfo(i);
+      state_write(buffer, info.m_steering);
+      state_write(buffer, info.m_rotation);
+      state_write(buffer, info.m_deltaRotation);
+      state_write(buffer, info.m_engineForce);
+      state_write(buffer, info.m_brake);
+      state_write(buffer, info.m_clippedInvContactDotSuspension);
+      state_write(buffer, info.m_suspensionRelativeVelocity);
+      state_write(buffer, info.m_wheelsSuspensionForce);
+      state_write(buffer, info.m_skidInfo);
+    }
+  }
+
+  /* Restore the saved state to reset the collision caches, the simulation following the save
+   * is then the same as the one following a restore. */
+  return RestoreState(buffer);
+}
+
+bool CcdPhysicsEnvironment::RestoreState(const std::vector<unsigned char> &buffer)
+{
+  size_t offset = 0;
+  uint32_t version;
+  uint8_t scalarSize;
+  btScalar localTime;
+  uint64_t solverSeed;
+  uint32_t numControllers;
+  if (!state_read(buffer, offset, version) || version != stateVersion ||
+      !state_read(buffer, offset, scalarSize) || scalarSize != sizeof(btScalar) ||
+      !state_read(buffer, offset, localTime) || !state_read(buffer, offset, solverSeed) ||
+      !state_read(buffer, offset, numControllers) || numControllers != m_controllers.size()) {
+    return false;
+  }
+
+  // Check the whole buffer before modifying the simulation.
+  for (int pass = 0; pass < 2; ++pass) {
+    const bool apply = (pass == 1);
+    size_t current = offset;
+
+    for (CcdPhysicsController *ctrl : m_controllers) {
+      uint64_t id;
+      btTransform transform;
+      btTransform interpolationTransform;
+      btVector3 interpolationLinearVelocity;
+      btVector3 interpolationAngularVelocity;
+      int32_t activationState;
+      btScalar deactivationTime;
+      btScalar hitFraction;
+      if (!state_read(buffer, current, id) || id != (uint64_t)(uintptr_t)ctrl ||
+          !state_read(buffer, current, transform) ||
+          !state_read(buffer, current, interpolationTransform) ||
+          !state_read(buffer, current, interpolationLinearVelocity) ||
+          !state_read(buffer, current, interpolationAngularVelocity) ||
+          !state_read(buffer, current, activationState) ||
+          !state_read(buffer, current, deactivationTime) ||
+          !state_read(buffer, current, hitFraction)) {
+        return false;
+      }
+
+      btRigidBody *body = ctrl->GetRigidBody();
+      btVector3 linearVelocity;
+      btVector3 angularVelocity;
+      btVector3 totalForce;
+      btVector3 totalTorque;
+      if (body && (!state_read(buffer, current, linearVelocity) ||
+                   !state_read(buffer, current, angularVelocity) ||
+                   !state_read(buffer, current, totalForce) ||
+                   !state_read(buffer, current, totalTorque))) {
+        return false;
+      }
+
+      BlenderBulletCharacterController *character =
+          static_cast<BlenderBulletCharacterController *>(ctrl->GetCharacterController());
+      BlenderBulletCharacterController::State characterState;
+      if (character && !state_read(buffer, current, characterState)) {
+        return false;
+      }
+
+      btSoftBody *softBody = ctrl->GetSoftBody();
+      if (softBody && !state_read(buffer, current, *softBody, apply)) {
+        return false;
+      }
+
+      if (!apply) {
+        continue;
+      }
+
+      btCollisionObject *object = ctrl->GetCollisionObject();
+      object->setWorldTransform(transform);
+      object->setInterpolationWorldTransform(interpolationTransform);
+      object->setInterpolationLinearVelocity(interpolationLinearVelocity);
+      object->setInterpolationAngularVelocity(interpolationAngularVelocity);
+      object->forceActivationState(activationState);
+      object->setDeactivationTime(deactivationTime);
+      object->setHitFraction(hitFraction);
+
+      if (body) {
+        body->setLinearVelocity(linearVelocity);
+        body->setAngularVelocity(angularVelocity);
+        body->clearForces();
+        body->applyCentralForce(totalForce);
+        body->applyTorque(totalTorque);
+        body->updateInertiaTensor();
+      }
+
+      if (character) {
+        character->SetState(characterState);
+      }
+
+      // Move the game object to the restored transform.
+      if (softBody) {
+        ctrl->SynchronizeMotionStates(0.0f);
+      }
+      else if (!object->isStaticObject()) {
+        PHY_IMotionState *motionState = ctrl->GetMotionState();
+        motionState->SetWorldOrientation(ToMoto(transform.getBasis()));
+        motionState->SetWorldPosition(ToMoto(transform.getOrigin()));
+        motionState->CalculateWorldTransformations();
+      }
+    }
+
+    const btCollisionObjectArray &objects = m_dynamicsWorld->getCollisionObjectArray();
+    int32_t numObjects;
+    if (!state_read(buffer, current, numObjects) || numObjects != objects.size()) {
+      return false;
+    }
+    for (int i = 0; i < numObjects; ++i) {
+      uint64_t id;
+      if (!state_read(buffer, current, id) ||
+          id != (uint64_t)(uintptr_t)objects[i]->getUserPointer()) {
+        return false;
+      }
+    }
+
+    // The manifolds are given back to the collision algorithms created by the next step.
+    CcdCollisionDispatcher *dispatcher = static_cast<CcdCollisionDispatcher *>(
+        m_dynamicsWorld->getDispatcher());
+    if (apply) {
+      dispatcher->ClearRestoredManifolds();
+    }
+    int32_t numManifolds;
+    if (!state_read(buffer, current, numManifolds) || numManifolds < 0) {
+      return false;
+    }
+    for (int i = 0; i < numManifolds; ++i) {
+      int32_t index0, index1, numContacts;
+      if (!state_read(buffer, current, index0) || index0 < 0 || index0 >= numObjects ||
+          !state_read(buffer, current, index1) || index1 < 0 || index1 >= numObjects ||
+          !state_read(buffer, current, numContacts) || numContacts < 0 ||
+          numContacts > MANIFOLD_CACHE_SIZE) {
+        return false;
+      }
+      btPersistentManifold manifold;
+      manifold.setBodies(objects[index0], objects[index1]);
+      for (int j = 0; j < numContacts; ++j) {
+        btManifoldPoint point;
+        if (!state_read(buffer, current, point)) {
+          return false;
+        }
+        manifold.addManifoldPoint(point, true);
+      }
+      if (apply) {
+        dispatcher->AddRestoredManifold(manifold);
+      }
+    }
+
+    int32_t numConstraints;
+    if (!state_read(buffer, current, numConstraints) ||
+        numConstraints != m_dynamicsWorld->getNumConstraints()) {
+      return false;
+    }
+    for (int i = 0; i < numConstraints; ++i) {
+      btTypedConstraint *con = m_dynamicsWorld->getConstraint(i);
+      int32_t id;
+      bool enabled;
+      btScalar appliedImpulse;
+      if (!state_read(buffer, current, id) || id != con->getUserConstraintId() ||
+          !state_read(buffer, current, enabled) || !state_read(buffer, current, appliedImpulse)) {
+        return false;
+      }
+      if (apply) {
+        con->setEnabled(enabled);
+        con->internalSetAppliedImpulse(appliedImpulse);
+      }
+    }
+
+    uint32_t numVehicles;
+    if (!state_read(buffer, current, numVehicles) || numVehicles != m_wrapperVehicles.size()) {
+      return false;
+    }
+    for (WrapperVehicle *wrapper : m_wrapperVehicles) {
+      btRaycastVehicle *vehicle = wrapper->GetVehicle();
+      int32_t numWheels;
+      if (!state_read(buffer, current, numWheels) || numWheels != vehicle->getNumWheels()) {
+        return false;
+      }
+      for (int i = 0; i < numWheels; ++i) {
+        btWheelInfo info = vehicle->getWheelInfo(i);
+        if (!state_read(buffer, current, info.m_steering) ||
+            !state_read(buffer, current, info.m_rotation) ||
+            !state_read(buffer, current, info.m_deltaRotation) ||
+            !state_read(buffer, current, info.m_engineForce) ||
+            !state_read(buffer, current, info.m_brake) ||
+            !state_read(buffer, current, info.m_clippedInvContactDotSuspension) ||
+            !state_read(buffer, current, info.m_suspensionRelativeVelocity) ||
+            !state_read(buffer, current, info.m_wheelsSuspensionForce) ||
+            !state_read(buffer, current, info.m_skidInfo)) {
+          return false;
+        }
+        if (apply) {
+          vehicle->getWheelInfo(i) = info;
+          vehicle->updateWheelTransform(i, false);
+        }
+      }
+      if (apply) {
+        wrapper->SyncWheels();
+      }
+    }
+
+    if (current != buffer.size()) {
+      return false;
+    }
+  }
+
+  static_cast<CcdDynamicsWorld *>(m_dynamicsWorld)->SetLocalTime(localTime);
+  static_cast<btSequentialImpulseConstraintSolver *>(m_solver)->setRandSeed(solverSeed);
+
+  ResetCollisionCaches();
+
+  return true;
+}
+
+void CcdPhysicsEnvironment::ResetCollisionCaches()
+{
+  btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
+  static_cast<CcdDynamicsWorld *>(m_dynamicsWorld)->ReleasePredictiveContacts();
+
+  /* Destroying the broadphase proxies releases the pairs with their collision algorithms and
+   * manifolds, and the pairs of the ghost objects. */
+  btCollisionObjectArray &objects = m_dynamicsWorld->getCollisionObjectArray();
+  std::vector<std::pair<int, int>> filters(objects.size());
+  for (int i = 0, size = objects.size(); i < size; ++i) {
+    btCollisionObject *object = objects[i];
+    btBroadphaseProxy *proxy = object->getBroadphaseHandle();
+    filters[i] = {proxy->m_collisionFilterGroup, proxy->m_collisionFilterMask};
+    m_broadphase->destroyProxy(proxy, dispatcher);
+    object->setBroadphaseHandle(nullptr);
+  }
+  // Without proxies the broadphase trees and ids are reset.
+  m_broadphase->resetPool(dispatcher);
+
+  btSoftBodyArray &softBodies = m_dynamicsWorld->getSoftBodyArray();
+  for (int i = 0, size = softBodies.size(); i < size; ++i) {
+    btSoftBody *softBody = softBodies[i];
+    softBody->rebuildNodeTree();
+    // The face tree is built again by the next ray test and the cluster tree by the next step.
+    softBody->m_fdbvt.clear();
+    for (int j = 0, numFaces = softBody->m_faces.size(); j < numFaces; ++j) {
+      softBody->m_faces[j].m_leaf = nullptr;
+    }
+    softBody->m_cdbvt.clear();
+    for (int j = 0, numClusters = softBody->m_clusters.size(); j < numClusters; ++j) {
+      softBody->m_clusters[j]->m_leaf = nullptr;
+    }
+  }
+  m_dynamicsWorld->getWorldInfo().m_sparsesdf.Reset();
+
+  // Add the proxies again in the world order as btCollisionWorld::addCollisionObject.
+  for (int i = 0, size = objects.size(); i < size; ++i) {
+    btCollisionObject *object = objects[i];
+    btCollisionShape *shape = object->getCollisionShape();
+    btVector3 minAabb, maxAabb;
+    shape->getAabb(object->getWorldTransform(), minAabb, maxAabb);
+    object->setBroadphaseHandle(m_broadphase->createProxy(minAabb,
+                                                          maxAabb,
+                                                          shape->getShapeType(),
+                                                          object,
+                                                          filters[i].first,
+                                                          filters[i].second,
+                                                          dispatcher));
+    m_dynamicsWorld->updateSingleAabb(object);
+  }
+}
+
 CcdPhysicsEnvironment::~CcdPhysicsEnvironment()
 {
   m_wrapperVehicles.clear();
@@ -70,6 +70,9 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
   void RemoveVehicle(CcdPhysicsController *ctrl, bool free);
   /// Restore the constraint if the owner and target are presents.
   void RestoreConstraint(CcdPhysicsController *ctrl, btTypedConstraint *con);
+  /** Create again the broadphase proxies and the soft body trees from the current state, the
+   * collision caches are then the same after a save and after a restore of this state. */
+  void ResetCollisionCaches();
 
  protected:
   btIDebugDraw *m_debugDrawer;
@@ -282,6 +285,9 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
 
   void MergeEnvironment(PHY_IPhysicsEnvironment *other_env);
 
+  virtual bool SaveState(std::vector<unsigned char> &buffer);
+  virtual bool RestoreState(const std::vector<unsigned char> &buffer);
+
   static CcdPhysicsEnvironment *Create(struct Scene *blenderscene, bool visualizePhysics);
 
   virtual void ConvertObject(BL_BlenderSceneConverter *converter,
@@ -302,6 +308,10 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
 
  protected:
   std::set<CcdPhysicsController *> m_controllers;
+  /// Controllers of rigid bodies using Fh springs.
+  std::vector<CcdPhysicsController *> m_fhControllers;
+  /// Controllers of soft bodies.
+  std::vector<CcdPhysicsController *> m_softBodyControllers;
 
   PHY_ResponseCallback m_triggerCallbacks[PHY_NUM_RESPONSE];
   void *m_triggerCallbacksUserPtrs[PHY_NUM_RESPONSE];
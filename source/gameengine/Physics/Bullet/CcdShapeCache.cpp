@@ -0,0 +1,273 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Physics/Bullet/CcdShapeCache.cpp
+ *  \ingroup physbullet
+ */
+
+#include "CcdShapeCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
+#include "BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h"
+#include "BulletCollision/CollisionShapes/btOptimizedBvh.h"
+
+#include "CM_Message.h"
+
+/// Bump when the serialized BVH layout or the triangles hash change.
+static const uint32_t bvhFileVersion = 2;
+static const char bvhFileMagic[4] = {'B', 'G', 'E', 'B'};
+/// Written in the native byte order, reads back differently on a machine of another endianness.
+static const uint32_t bvhFileEndianMark = 0x01020304;
+
+/** The serialized BVH is an in place image of the Bullet structures, it is only valid for the
+ * same scalar type, pointer size, structure layout, byte order and Bullet version.
+ */
+struct BvhFileHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t hash;
+  uint32_t endianMark;
+  uint32_t bulletVersion;
+  uint32_t scalarSize;
+  uint32_t pointerSize;
+  uint32_t bvhSize;
+  uint32_t bufferSize;
+};
+
+static void bvh_file_header_init(BvhFileHeader &header, uint64_t hash, uint32_t bufferSize)
+{
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, bvhFileMagic, sizeof(bvhFileMagic));
+  header.version = bvhFileVersion;
+  header.hash = hash;
+  header.endianMark = bvhFileEndianMark;
+  header.bulletVersion = BT_BULLET_VERSION;
+  header.scalarSize = sizeof(btScalar);
+  header.pointerSize = sizeof(void *);
+  header.bvhSize = sizeof(btOptimizedBvh);
+  header.bufferSize = bufferSize;
+}
+
+static bool bvh_file_header_valid(const BvhFileHeader &header, uint64_t hash)
+{
+  BvhFileHeader expected;
+  bvh_file_header_init(expected, hash, header.bufferSize);
+
+  return (memcmp(header.magic, expected.magic, sizeof(header.magic)) == 0 &&
+          header.version == expected.version && header.hash == expected.hash &&
+          header.endianMark == expected.endianMark &&
+          header.bulletVersion == expected.bulletVersion &&
+          header.scalarSize == expected.scalarSize &&
+          header.pointerSize == expected.pointerSize && header.bvhSize == expected.bvhSize &&
+          header.bufferSize >= sizeof(btOptimizedBvh));
+}
+
+std::map<uint64_t, CcdOptimizedBvh *> CcdShapeCache::m_bvhMap;
+std::string CcdShapeCache::m_directory;
+CM_ThreadMutex CcdShapeCache::m_mutex;
+
+CcdOptimizedBvh::CcdOptimizedBvh(btOptimizedBvh *bvh, void *buffer, uint64_t hash)
+    : m_bvh(bvh), m_buffer(buffer), m_hash(hash)
+{
+}
+
+CcdOptimizedBvh::~CcdOptimizedBvh()
+{
+  m_bvh->~btOptimizedBvh();
+  // A deserialized BVH is constructed in place in its buffer.
+  btAlignedFree(m_buffer ? m_buffer : m_bvh);
+}
+
+uint64_t CcdShapeCache::ComputeHash(const btScalar *vertices,
+                                    unsigned int numScalars,
+                                    const int *indices,
+                                    unsigned int numIndices)
+{
+  // FNV-1a, enough to tell apart meshes and cheap compared to the BVH build.
+  uint64_t hash = 14695981039346656037ULL;
+  const auto hashBytes = [&hash](const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+  };
+
+  hashBytes(&numScalars, sizeof(numScalars));
+  hashBytes(&numIndices, sizeof(numIndices));
+  hashBytes(vertices, numScalars * sizeof(btScalar));
+  hashBytes(indices, numIndices * sizeof(int));
+
+  return hash;
+}
+
+std::string CcdShapeCache::GetFilePath(const std::string &directory, uint64_t hash)
+{
+  char filename[FILE_MAX];
+  BLI_snprintf(filename, sizeof(filename), "%016llx.bvh", (unsigned long long)hash);
+
+  char path[FILE_MAX];
+  BLI_join_dirfile(path, sizeof(path), directory.c_str(), filename);
+
+  return path;
+}
+
+CcdOptimizedBvh *CcdShapeCache::ReadBvh(const std::string &directory, uint64_t hash)
+{
+  const std::string path = GetFilePath(directory, hash);
+  FILE *file = BLI_fopen(path.c_str(), "rb");
+  if (!file) {
+    return nullptr;
+  }
+
+  BvhFileHeader header;
+  void *buffer = nullptr;
+  if (fread(&header, sizeof(header), 1, file) == 1 && bvh_file_header_valid(header, hash)) {
+    buffer = btAlignedAlloc(header.bufferSize, 16);
+    if (fread(buffer, header.bufferSize, 1, file) != 1) {
+      btAlignedFree(buffer);
+      buffer = nullptr;
+    }
+  }
+  fclose(file);
+
+  if (!buffer) {
+    CM_Warning("invalid physics shape cache file \"" << path << "\", rebuilding it");
+    return nullptr;
+  }
+
+  btOptimizedBvh *bvh = btOptimizedBvh::deSerializeInPlace(buffer, header.bufferSize, false);
+  if (!bvh) {
+    btAlignedFree(buffer);
+    return nullptr;
+  }
+
+  return new CcdOptimizedBvh(bvh, buffer, hash);
+}
+
+void CcdShapeCache::WriteBvh(const std::string &directory, btOptimizedBvh *bvh, uint64_t hash)
+{
+  const unsigned int bufferSize = bvh->calculateSerializeBufferSize();
+  void *buffer = btAlignedAlloc(bufferSize, 16);
+  if (!bvh->serializeInPlace(buffer, bufferSize, false)) {
+    btAlignedFree(buffer);
+    return;
+  }
+
+  if (!BLI_is_dir(directory.c_str()) && !BLI_dir_create_recursive(directory.c_str())) {
+    CM_Warning("unable to create physics shape cache directory \"" << directory << "\"");
+    btAlignedFree(buffer);
+    return;
+  }
+
+  BvhFileHeader header;
+  bvh_file_header_init(header, hash, bufferSize);
+
+  // Write to a temporary file first so a concurrent reader never sees a partial file.
+  const std::string path = GetFilePath(directory, hash);
+  const std::string tmppath = path + ".tmp";
+  FILE *file = BLI_fopen(tmppath.c_str(), "wb");
+  if (file) {
+    const bool written = (fwrite(&header, sizeof(header), 1, file) == 1 &&
+                          fwrite(buffer, bufferSize, 1, file) == 1);
+    fclose(file);
+    if (!written || BLI_rename(tmppath.c_str(), path.c_str()) != 0) {
+      BLI_delete(tmppath.c_str(), false, false);
+      CM_Warning("unable to write physics shape cache file \"" << path << "\"");
+    }
+  }
+
+  btAlignedFree(buffer);
+}
+
+CcdOptimizedBvh *CcdShapeCache::GetBvh(btBvhTriangleMeshShape *shape, uint64_t hash)
+{
+  m_mutex.Lock();
+  std::map<uint64_t, CcdOptimizedBvh *>::iterator it = m_bvhMap.find(hash);
+  if (it != m_bvhMap.end()) {
+    CcdOptimizedBvh *cached = it->second->AddRef();
+    m_mutex.Unlock();
+    return cached;
+  }
+  const std::string directory = m_directory;
+  m_mutex.Unlock();
+
+  const bool useDisk = !directory.empty();
+  CcdOptimizedBvh *cached = useDisk ? ReadBvh(directory, hash) : nullptr;
+  if (!cached) {
+    // Build the BVH the same way btBvhTriangleMeshShape does.
+    void *mem = btAlignedAlloc(sizeof(btOptimizedBvh), 16);
+    btOptimizedBvh *bvh = new (mem) btOptimizedBvh();
+    bvh->build(shape->getMeshInterface(),
+               shape->usesQuantizedAabbCompression(),
+               shape->getLocalAabbMin(),
+               shape->getLocalAabbMax());
+
+    if (useDisk) {
+      WriteBvh(directory, bvh, hash);
+    }
+
+    cached = new CcdOptimizedBvh(bvh, nullptr, hash);
+  }
+
+  m_mutex.Lock();
+  // Another thread could have cooked the same mesh meanwhile, keep only one of them.
+  std::pair<std::map<uint64_t, CcdOptimizedBvh *>::iterator, bool> result = m_bvhMap.insert(
+      {hash, cached});
+  if (!result.second) {
+    delete cached;
+    cached = result.first->second->AddRef();
+  }
+  m_mutex.Unlock();
+
+  return cached;
+}
+
+void CcdShapeCache::ReleaseBvh(CcdOptimizedBvh *bvh)
+{
+  m_mutex.Lock();
+  if (bvh->GetRefCount() == 1) {
+    m_bvhMap.erase(bvh->m_hash);
+  }
+  bvh->Release();
+  m_mutex.Unlock();
+}
+
+void CcdShapeCache::SetDirectory(const std::string &directory)
+{
+  m_mutex.Lock();
+  m_directory = directory;
+  m_mutex.Unlock();
+}
+
+std::string CcdShapeCache::GetDirectory()
+{
+  m_mutex.Lock();
+  const std::string directory = m_directory;
+  m_mutex.Unlock();
+  return directory;
+}
@@ -0,0 +1,96 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CcdShapeCache.h
+ *  \ingroup physbullet
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "LinearMath/btScalar.h"
+
+#include "CM_RefCount.h"
+#include "CM_Thread.h"
+
+class btOptimizedBvh;
+class btBvhTriangleMeshShape;
+
+/** \brief A cooked triangle mesh BVH shared by all the shapes using the same triangles.
+ * The BVH is either built in memory or loaded from a serialized buffer of the disk cache.
+ */
+class CcdOptimizedBvh : public CM_RefCount<CcdOptimizedBvh> {
+  friend class CcdShapeCache;
+
+ private:
+  btOptimizedBvh *m_bvh;
+  /// Aligned buffer of a deserialized BVH, the BVH is constructed in place in it.
+  void *m_buffer;
+  uint64_t m_hash;
+
+  CcdOptimizedBvh(btOptimizedBvh *bvh, void *buffer, uint64_t hash);
+
+ public:
+  virtual ~CcdOptimizedBvh();
+
+  btOptimizedBvh *GetBvh() const
+  {
+    return m_bvh;
+  }
+};
+
+/** \brief Cache of cooked triangle mesh shapes.
+ * The BVHs are indexed by a hash of the triangles content, so that identical meshes share the
+ * same BVH in memory and a modified mesh never reuses a stale one. When a directory is set the
+ * quantized BVHs are also stored serialized on disk and loaded back by the next conversions.
+ */
+class CcdShapeCache {
+  friend class CcdOptimizedBvh;
+
+ private:
+  static std::map<uint64_t, CcdOptimizedBvh *> m_bvhMap;
+  static std::string m_directory;
+  static CM_ThreadMutex m_mutex;
+
+  static std::string GetFilePath(const std::string &directory, uint64_t hash);
+  static CcdOptimizedBvh *ReadBvh(const std::string &directory, uint64_t hash);
+  static void WriteBvh(const std::string &directory, btOptimizedBvh *bvh, uint64_t hash);
+
+ public:
+  /// Hash the content of a triangle mesh.
+  static uint64_t ComputeHash(const btScalar *vertices,
+                              unsigned int numScalars,
+                              const int *indices,
+                              unsigned int numIndices);
+
+  /** Return a BVH for the triangle mesh of shape created without BVH, the BVH is looked up in
+   * memory, then on disk and built at last. The returned reference must be released with
+   * ReleaseBvh.
+   */
+  static CcdOptimizedBvh *GetBvh(btBvhTriangleMeshShape *shape, uint64_t hash);
+  static void ReleaseBvh(CcdOptimizedBvh *bvh);
+
+  /// Set the directory of the disk cache, an empty path disables the disk cache.
+  static void SetDirectory(const std::string &directory);
+  static std::string GetDirectory();
+};
@@ -0,0 +1,224 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup physbullet
+ */
+
+#include "testing/testing.h"
+
+#include <vector>
+
+#include "BulletCollision/CollisionShapes/btBoxShape.h"
+#include "BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h"
+#include "BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h"
+#include "BulletSoftBody/btSoftBody.h"
+
+#include "CcdPhysicsController.h"
+#include "CcdPhysicsEnvironment.h"
+
+namespace {
+
+const float frameTime = 1.0f / 60.0f;
+const unsigned int rollbackFrames = 10;
+
+CcdPhysicsController *add_box(CcdPhysicsEnvironment *env,
+                              const btVector3 &position,
+                              const btVector3 &halfExtents,
+                              float mass)
+{
+  DefaultMotionState *motionState = new DefaultMotionState();
+  motionState->m_worldTransform.setIdentity();
+  motionState->m_worldTransform.setOrigin(position);
+
+  const bool dynamic = (mass > 0.0f);
+
+  CcdConstructionInfo ci;
+  ci.m_collisionShape = new btBoxShape(halfExtents);
+  ci.m_MotionState = motionState;
+  ci.m_physicsEnv = env;
+  ci.m_mass = mass;
+  ci.m_bDyna = dynamic;
+  ci.m_bRigid = dynamic;
+  ci.m_collisionFilterGroup = dynamic ? short(CcdConstructionInfo::DefaultFilter) :
+                                        short(CcdConstructionInfo::StaticFilter);
+  ci.m_collisionFilterMask = dynamic ? short(CcdConstructionInfo::AllFilter) :
+                                       short(CcdConstructionInfo::AllFilter ^
+                                             CcdConstructionInfo::StaticFilter);
+
+  CcdPhysicsController *ctrl = new CcdPhysicsController(ci);
+  env->AddCcdPhysicsController(ctrl);
+
+  return ctrl;
+}
+
+/// Square cloth of resolution x resolution vertices using shape matching.
+struct Cloth {
+  std::vector<btScalar> vertices;
+  std::vector<int> indices;
+  btTriangleIndexVertexArray *mesh;
+  CcdShapeConstructionInfo *shapeInfo;
+  CcdPhysicsController *ctrl;
+
+  Cloth(CcdPhysicsEnvironment *env, const btVector3 &position, float size, int resolution)
+  {
+    for (int y = 0; y < resolution; ++y) {
+      for (int x = 0; x < resolution; ++x) {
+        vertices.push_back(size * (float(x) / (resolution - 1) - 0.5f));
+        vertices.push_back(size * (float(y) / (resolution - 1) - 0.5f));
+        vertices.push_back(0.0f);
+      }
+    }
+    for (int y = 0; y < resolution - 1; ++y) {
+      for (int x = 0; x < resolution - 1; ++x) {
+        const int i = y * resolution + x;
+        indices.insert(indices.end(), {i, i + 1, i + resolution});
+        indices.insert(indices.end(), {i + 1, i + resolution + 1, i + resolution});
+      }
+    }
+    mesh = new btTriangleIndexVertexArray(indices.size() / 3,
+                                          indices.data(),
+                                          3 * sizeof(int),
+                                          vertices.size() / 3,
+                                          vertices.data(),
+                                          3 * sizeof(btScalar));
+    // The soft body creation needs a shape info, without mesh to update.
+    shapeInfo = new CcdShapeConstructionInfo();
+
+    DefaultMotionState *motionState = new DefaultMotionState();
+    motionState->m_worldTransform.setIdentity();
+    motionState->m_worldTransform.setOrigin(position);
+
+    CcdConstructionInfo ci;
+    ci.m_collisionShape = new btBvhTriangleMeshShape(mesh, true);
+    ci.m_MotionState = motionState;
+    ci.m_physicsEnv = env;
+    ci.m_shapeInfo = shapeInfo;
+    ci.m_mass = 1.0f;
+    ci.m_margin = 0.1f;
+    ci.m_bDyna = true;
+    ci.m_bSoft = true;
+    ci.m_gamesoftFlag = CCD_BSB_SHAPE_MATCHING;
+    ci.m_soft_linStiff = 0.5f;
+    ci.m_soft_kMT = 0.1f;
+
+    ctrl = new CcdPhysicsController(ci);
+    env->AddCcdPhysicsController(ctrl);
+  }
+
+  ~Cloth()
+  {
+    delete ctrl;
+    shapeInfo->Release();
+    delete mesh;
+  }
+};
+
+/// Simulate frames and return the transforms and soft body nodes at each frame.
+std::vector<btScalar> simulate(CcdPhysicsEnvironment *env,
+                               const std::vector<CcdPhysicsController *> &controllers,
+                               double &curTime,
+                               unsigned int frames)
+{
+  std::vector<btScalar> values;
+  for (unsigned int i = 0; i < frames; ++i) {
+    curTime += frameTime;
+    env->ProceedDeltaTime(curTime, frameTime, frameTime);
+
+    for (CcdPhysicsController *ctrl : controllers) {
+      const btTransform &trans = ctrl->GetCollisionObject()->getWorldTransform();
+      const btQuaternion rot = trans.getRotation();
+      for (unsigned short j = 0; j < 3; ++j) {
+        values.push_back(trans.getOrigin()[j]);
+      }
+      for (unsigned short j = 0; j < 4; ++j) {
+        values.push_back(rot[j]);
+      }
+
+      btSoftBody *softBody = ctrl->GetSoftBody();
+      if (softBody) {
+        for (int j = 0; j < softBody->m_nodes.size(); ++j) {
+          for (unsigned short k = 0; k < 3; ++k) {
+            values.push_back(softBody->m_nodes[j].m_x[k]);
+          }
+        }
+      }
+    }
+  }
+
+  return values;
+}
+
+}  // namespace
+
+// The simulation from a restored state must be exactly the simulation which followed the save.
+TEST(ccd_physics_environment, RollbackDeterministic)
+{
+  CcdPhysicsEnvironment *env = new CcdPhysicsEnvironment(PHY_SOLVER_SEQUENTIAL, false);
+
+  std::vector<CcdPhysicsController *> controllers;
+  controllers.push_back(
+      add_box(env, btVector3(0.0f, 0.0f, -1.0f), btVector3(10.0f, 10.0f, 1.0f), 0.0f));
+  // A leaning stack of boxes, with contacts between them and with the ground.
+  for (unsigned short i = 0; i < 4; ++i) {
+    controllers.push_back(add_box(env,
+                                  btVector3(0.15f * i, 0.05f * i, 0.5f + 1.01f * i),
+                                  btVector3(0.5f, 0.5f, 0.5f),
+                                  1.0f));
+  }
+  // A cloth falling on the stack.
+  Cloth *cloth = new Cloth(env, btVector3(0.4f, 0.1f, 4.3f), 1.5f, 6);
+  controllers.push_back(cloth->ctrl);
+
+  double curTime = 0.0;
+  // Let the boxes and the cloth touch before saving.
+  simulate(env, controllers, curTime, 20);
+
+  std::vector<unsigned char> saved;
+  ASSERT_TRUE(env->SaveState(saved));
+  const double savedTime = curTime;
+
+  const std::vector<btScalar> original = simulate(env, controllers, curTime, rollbackFrames);
+  std::vector<unsigned char> advanced;
+  ASSERT_TRUE(env->SaveState(advanced));
+  EXPECT_NE(saved, advanced);
+
+  ASSERT_TRUE(env->RestoreState(saved));
+  // The restored state is exactly the saved state.
+  std::vector<unsigned char> restored;
+  ASSERT_TRUE(env->SaveState(restored));
+  EXPECT_EQ(saved, restored);
+
+  curTime = savedTime;
+  const std::vector<btScalar> resimulated = simulate(env, controllers, curTime, rollbackFrames);
+
+  ASSERT_EQ(original.size(), resimulated.size());
+  for (unsigned int i = 0; i < original.size(); ++i) {
+    EXPECT_EQ(original[i], resimulated[i]) << "value " << i;
+  }
+
+  // A state doesn't apply to an environment with other controllers.
+  controllers.pop_back();
+  controllers.push_back(
+      add_box(env, btVector3(5.0f, 5.0f, 5.0f), btVector3(0.5f, 0.5f, 0.5f), 1.0f));
+  EXPECT_FALSE(env->RestoreState(saved));
+
+  delete cloth;
+  for (CcdPhysicsController *ctrl : controllers) {
+    delete ctrl;
+  }
+  delete env;
+}
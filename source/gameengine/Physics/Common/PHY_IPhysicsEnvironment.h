@@ -39,6 +39,7 @@
 #include "PHY_DynamicTypes.h"
 
 #include <array>
+#include <vector>
 
 class PHY_IConstraint;
 class PHY_IVehicle;
@@ -258,6 +259,26 @@ class PHY_IPhysicsEnvironment {
 
   virtual void MergeEnvironment(PHY_IPhysicsEnvironment *other_env) = 0;
 
+  /** Save the simulation state of the physics objects, contacts, constraints and vehicles.
+   * The collision caches are reset as by RestoreState, the simulation which follows the save is
+   * then the one following any restore of the state.
+   * \param buffer Filled with the state, only valid for this environment.
+   * \return False if the environment doesn't support the state saving.
+   */
+  virtual bool SaveState(std::vector<unsigned char> &buffer)
+  {
+    return false;
+  }
+  /** Restore a simulation state saved by SaveState, the environment must contain the same
+   * physics objects, constraints and vehicles than when the state was saved.
+   * The simulation from a restored state is exactly the simulation which followed the save.
+   * \return False if the state doesn't match the environment.
+   */
+  virtual bool RestoreState(const std::vector<unsigned char> &buffer)
+  {
+    return false;
+  }
+
   virtual void ConvertObject(BL_BlenderSceneConverter *converter,
                              KX_GameObject *gameobj,
                              RAS_MeshObject *meshobj,